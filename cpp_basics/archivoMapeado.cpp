@@ -0,0 +1,90 @@
+/*
+ * Este archivo no contiene un `main()`: permite acceder al contenido de un archivo
+ * sin copiarlo a memoria con `mmap(2)`. El sistema operativo «proyecta» el archivo
+ * en nuestro espacio de direcciones y lo va cargando por páginas a medida que lo
+ * leemos, con lo que podemos recorrerlo como si fuera un gran array de `char`s
+ * sin reservar memoria ni copiar nada.
+ *
+ * No todos los archivos se pueden proyectar: una tubería (e.g. `cat libro.txt | ...`)
+ * o la entrada estándar no tienen un tamaño conocido. Para ellos ofrecemos
+ * `leeBloque()`, que los lee por bloques con `read(2)`.
+ * Más información -> https://www.man7.org/linux/man-pages/man2/mmap.2.html
+ */
+
+/*
+ * Define `std::string`.
+ * Más información -> https://en.cppreference.com/w/cpp/header/string
+ */
+#include <string>
+
+/*
+ * Define `errno` y `EINTR` para reintentar las lecturas interrumpidas por una señal.
+ * Más información -> https://en.cppreference.com/w/cpp/header/cerrno
+ */
+#include <cerrno>
+
+/*
+ * Estas cabeceras son parte de la interfaz POSIX y no de la librería estándar de
+ * C++: definen `open()`, `fstat()`, `mmap()`, `read()` y `close()`.
+ */
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+struct ArchivoMapeado {
+    // El descriptor del archivo abierto; `-1` si no se ha podido abrir.
+    int fd;
+    // El contenido proyectado y su tamaño. `datos` es `NULL` si no se ha podido proyectar.
+    const char* datos;
+    size_t tam;
+};
+
+/*
+ * Abre `ruta` e intenta proyectarlo. La ruta `-` representa la entrada estándar.
+ * Tras la llamada conviene comprobar:
+ *  - `fd < 0`: no se ha podido abrir el archivo.
+ *  - `datos == NULL`: no se puede proyectar (e.g. es una tubería); hay que usar `leeBloque()`.
+ */
+ArchivoMapeado abreArchivo(std::string const& ruta) {
+    ArchivoMapeado a = {-1, NULL, 0};
+    a.fd = ruta == "-" ? STDIN_FILENO : open(ruta.c_str(), O_RDONLY);
+    if (a.fd < 0)
+        return a;
+
+    struct stat info;
+    if (fstat(a.fd, &info) < 0 || !S_ISREG(info.st_mode) || info.st_size == 0)
+        return a;
+
+    void* p = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, a.fd, 0);
+    if (p == MAP_FAILED)
+        return a;
+
+    // Avisamos al sistema de que leeremos el archivo de principio a fin para que lo cargue por adelantado.
+    madvise(p, info.st_size, MADV_SEQUENTIAL);
+    a.datos = (const char*) p;
+    a.tam = info.st_size;
+    return a;
+}
+
+/*
+ * Lee hasta `capacidad` bytes del archivo en `buffer`. Devuelve los bytes leídos,
+ * `0` al llegar al final y un número negativo si hay un error.
+ */
+long leeBloque(ArchivoMapeado const& a, char* buffer, size_t capacidad) {
+    long n;
+    do {
+        n = read(a.fd, buffer, capacidad);
+    } while (n < 0 && errno == EINTR);
+    return n;
+}
+
+void cierraArchivo(ArchivoMapeado& a) {
+    if (a.datos != NULL)
+        munmap((void*) a.datos, a.tam);
+    if (a.fd > STDIN_FILENO)
+        close(a.fd);
+    a.fd = -1;
+    a.datos = NULL;
+    a.tam = 0;
+}
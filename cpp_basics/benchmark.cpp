@@ -0,0 +1,427 @@
+/*
+ * Este archivo no contiene un `main()`: es un pequeño «arnés» para medir cuánto
+ * tardan fragmentos de código (a los que llamaremos «núcleos» o *kernels*) de una
+ * forma algo más rigurosa que con `time ./programa.ex`:
+ *  - Ejecuta cada núcleo varias veces sin medir (calentamiento) para que las cachés,
+ *    la frecuencia del procesador... se estabilicen.
+ *  - Repite la medida muchas veces y resume los tiempos con su mediana, su
+ *    percentil 95, su media y su desviación típica. La mediana es mucho menos
+ *    sensible que la media a ejecuciones puntualmente lentas.
+ *  - Si el sistema lo permite, cuenta los ciclos e instrucciones ejecutados con
+ *    los contadores hardware del procesador a través de `perf_event_open(2)`.
+ *  - Muestra los resultados como una tabla, en JSON o en CSV.
+ *
+ * Para usarlo basta con registrar los núcleos con `registraBenchmark()` y llamar a
+ * `ejecutaBenchmarks()` desde `main()`. Podéis ver un ejemplo en `benchmarks.cpp`.
+ */
+
+/*
+ * Define `std::cout` para escribir a pantalla (i.e. `stdout`).
+ * Más información -> https://en.cppreference.com/w/cpp/header/iostream
+ */
+#include <iostream>
+
+/*
+ * Define `std::fstream` para leer los CSV a comparar.
+ * Más información -> https://en.cppreference.com/w/cpp/header/fstream
+ */
+#include <fstream>
+
+/*
+ * Define `std::istringstream` para trocear cada línea de un CSV.
+ * Más información -> https://en.cppreference.com/w/cpp/header/sstream
+ */
+#include <sstream>
+
+/*
+ * Define `std::setw()` y `std::setprecision()` para alinear las tablas.
+ * Más información -> https://en.cppreference.com/w/cpp/header/iomanip
+ */
+#include <iomanip>
+
+/*
+ * Define `std::string`, `std::stoi()` y `std::stod()`.
+ * Más información -> https://en.cppreference.com/w/cpp/header/string
+ */
+#include <string>
+
+/*
+ * Define `std::vector`.
+ * Más información -> https://en.cppreference.com/w/cpp/header/vector
+ */
+#include <vector>
+
+/*
+ * Define `std::map`, que usaremos para agrupar los resultados de los CSV.
+ * Más información -> https://en.cppreference.com/w/cpp/header/map
+ */
+#include <map>
+
+/*
+ * Define `std::function`, capaz de guardar cualquier cosa «llamable». Como solo la
+ * invocamos una vez por repetición su coste es despreciable frente al del núcleo.
+ * Más información -> https://en.cppreference.com/w/cpp/header/functional
+ */
+#include <functional>
+
+/*
+ * Define `std::sort()`, que necesitamos para calcular la mediana y los percentiles.
+ * Más información -> https://en.cppreference.com/w/cpp/header/algorithm
+ */
+#include <algorithm>
+
+/*
+ * Define `std::chrono::steady_clock`, un reloj que nunca «salta» hacia atrás.
+ * Más información -> https://en.cppreference.com/w/cpp/header/chrono
+ */
+#include <chrono>
+
+/*
+ * Define `std::sqrt()` para calcular la desviación típica de los tiempos.
+ * Más información -> https://en.cppreference.com/w/cpp/header/cmath
+ */
+#include <cmath>
+
+/*
+ * Los contadores hardware son una funcionalidad exclusiva de Linux: en cualquier
+ * otro sistema simplemente no los mostraremos.
+ * Más información -> https://www.man7.org/linux/man-pages/man2/perf_event_open.2.html
+ */
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#define PERF_COUNT_HW_CPU_CYCLES 0
+#define PERF_COUNT_HW_INSTRUCTIONS 1
+#endif
+
+/*
+ * Impide que el compilador descarte un cálculo cuyo resultado no se usa. El
+ * bloque `asm` vacío «consume» el valor y el compilador, que no sabe qué hace,
+ * está obligado a calcularlo. Sin esto, con `-O2` algunos núcleos desaparecerían.
+ */
+template <typename T>
+void noOptimizar(T const& valor) {
+    asm volatile("" : : "g"(valor) : "memory");
+}
+
+struct Benchmark {
+    std::string nombre;
+    std::function<void()> nucleo;
+};
+
+// Los resultados de medir un núcleo. Los tiempos están en segundos.
+struct ResultadoBenchmark {
+    std::string nombre;
+    int repeticiones;
+    double mediana, p95, media, desviacion, minimo;
+    // Valores medios por repetición; son negativos si no hay contadores disponibles.
+    double ciclos, instrucciones;
+};
+
+// La lista de núcleos registrados. Es una función para evitar problemas con el orden de inicialización.
+std::vector<Benchmark>& benchmarks() {
+    static std::vector<Benchmark> lista;
+    return lista;
+}
+
+void registraBenchmark(std::string const& nombre, std::function<void()> nucleo) {
+    Benchmark b = {nombre, nucleo};
+    benchmarks().push_back(b);
+}
+
+/*
+ * Abre un contador hardware para el hilo actual y los que cree a partir de ahora
+ * (i.e. `inherit`). Devuelve `-1` si no es posible, e.g. dentro de muchos
+ * contenedores o si `/proc/sys/kernel/perf_event_paranoid` es demasiado restrictivo.
+ */
+int abreContador(unsigned long long evento) {
+#ifdef __linux__
+    perf_event_attr attr;
+    std::fill((char*) &attr, (char*) &attr + sizeof(attr), 0);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = evento;
+    attr.disabled = 1;
+    attr.inherit = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+#else
+    (void) evento;
+    return -1;
+#endif
+}
+
+void arrancaContador(int fd) {
+#ifdef __linux__
+    if (fd >= 0) {
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#else
+    (void) fd;
+#endif
+}
+
+// Detiene el contador y devuelve su valor; `-1` si no estaba disponible.
+double paraContador(int fd) {
+#ifdef __linux__
+    long long valor;
+    if (fd >= 0) {
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(fd, &valor, sizeof(valor)) == sizeof(valor))
+            return valor;
+    }
+#else
+    (void) fd;
+#endif
+    return -1;
+}
+
+void cierraContador(int fd) {
+#ifdef __linux__
+    if (fd >= 0)
+        close(fd);
+#else
+    (void) fd;
+#endif
+}
+
+// Percentil `p` (entre 0 y 100) de unos tiempos ya ordenados.
+double percentil(std::vector<double> const& ordenados, double p) {
+    double pos = p / 100 * (ordenados.size() - 1);
+    size_t i = pos;
+    if (i + 1 >= ordenados.size())
+        return ordenados.back();
+    return ordenados[i] + (pos - i) * (ordenados[i + 1] - ordenados[i]);
+}
+
+ResultadoBenchmark mideBenchmark(Benchmark const& b, int calentamiento, int repeticiones) {
+    for (int i = 0; i < calentamiento; i++)
+        b.nucleo();
+
+    int fdCiclos = abreContador(PERF_COUNT_HW_CPU_CYCLES);
+    int fdInstrucciones = abreContador(PERF_COUNT_HW_INSTRUCTIONS);
+    double ciclos = 0, instrucciones = 0;
+    std::vector<double> tiempos;
+
+    for (int i = 0; i < repeticiones; i++) {
+        arrancaContador(fdCiclos);
+        arrancaContador(fdInstrucciones);
+        std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+        b.nucleo();
+        std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+        ciclos += paraContador(fdCiclos);
+        instrucciones += paraContador(fdInstrucciones);
+        tiempos.push_back(std::chrono::duration<double>(t1 - t0).count());
+    }
+
+    cierraContador(fdCiclos);
+    cierraContador(fdInstrucciones);
+
+    ResultadoBenchmark r;
+    r.nombre = b.nombre;
+    r.repeticiones = repeticiones;
+    r.ciclos = fdCiclos >= 0 ? ciclos / repeticiones : -1;
+    r.instrucciones = fdInstrucciones >= 0 ? instrucciones / repeticiones : -1;
+
+    double suma = 0, suma2 = 0;
+    for (double t : tiempos) {
+        suma += t;
+        suma2 += t * t;
+    }
+    r.media = suma / repeticiones;
+    r.desviacion = repeticiones > 1 ? std::sqrt(std::max(0.0, (suma2 - suma * r.media) / (repeticiones - 1))) : 0;
+
+    std::sort(tiempos.begin(), tiempos.end());
+    r.minimo = tiempos.front();
+    r.mediana = percentil(tiempos, 50);
+    r.p95 = percentil(tiempos, 95);
+
+    return r;
+}
+
+void muestraTexto(std::vector<ResultadoBenchmark> const& resultados, std::string const& etiqueta) {
+    std::cout << "Compilación: " << etiqueta << "\n"
+              << std::left << std::setw(24) << "núcleo" << std::right
+              << std::setw(12) << "mediana(s)" << std::setw(12) << "p95(s)" << std::setw(12) << "desv(s)"
+              << std::setw(14) << "ciclos" << std::setw(14) << "instrucciones" << "\n";
+    for (ResultadoBenchmark const& r : resultados) {
+        std::cout << std::left << std::setw(24) << r.nombre << std::right << std::setprecision(4)
+                  << std::setw(12) << r.mediana << std::setw(12) << r.p95 << std::setw(12) << r.desviacion;
+        if (r.ciclos >= 0)
+            std::cout << std::setw(14) << std::setprecision(6) << r.ciclos << std::setw(14) << r.instrucciones << "\n";
+        else
+            std::cout << std::setw(14) << "n/d" << std::setw(14) << "n/d" << "\n";
+    }
+}
+
+void muestraJson(std::vector<ResultadoBenchmark> const& resultados, std::string const& etiqueta) {
+    std::cout << std::setprecision(9) << "{\"etiqueta\": \"" << etiqueta << "\", \"benchmarks\": [\n";
+    for (size_t i = 0; i < resultados.size(); i++) {
+        ResultadoBenchmark const& r = resultados[i];
+        std::cout << "  {\"nombre\": \"" << r.nombre << "\", \"repeticiones\": " << r.repeticiones
+                  << ", \"mediana\": " << r.mediana << ", \"p95\": " << r.p95 << ", \"media\": " << r.media
+                  << ", \"desviacion\": " << r.desviacion << ", \"minimo\": " << r.minimo;
+        if (r.ciclos >= 0)
+            std::cout << ", \"ciclos\": " << r.ciclos << ", \"instrucciones\": " << r.instrucciones;
+        else
+            std::cout << ", \"ciclos\": null, \"instrucciones\": null";
+        std::cout << "}" << (i + 1 < resultados.size() ? "," : "") << "\n";
+    }
+    std::cout << "]}\n";
+}
+
+void muestraCsv(std::vector<ResultadoBenchmark> const& resultados, std::string const& etiqueta) {
+    std::cout << std::setprecision(9)
+              << "etiqueta,nombre,repeticiones,mediana,p95,media,desviacion,minimo,ciclos,instrucciones\n";
+    for (ResultadoBenchmark const& r : resultados) {
+        std::cout << etiqueta << "," << r.nombre << "," << r.repeticiones << "," << r.mediana << "," << r.p95
+                  << "," << r.media << "," << r.desviacion << "," << r.minimo << ",";
+        if (r.ciclos >= 0)
+            std::cout << r.ciclos << "," << r.instrucciones << "\n";
+        else
+            std::cout << ",\n";
+    }
+}
+
+/*
+ * Lee uno o varios CSV concatenados (e.g. uno por nivel de optimización) y muestra
+ * una tabla con la mediana de cada núcleo en cada compilación, en el orden en el
+ * que aparecen las etiquetas. Las líneas de cabecera repetidas se ignoran.
+ */
+int comparaCsv(std::string const& ruta) {
+    std::fstream mif;
+    mif.open(ruta, std::ios::in);
+    if (!mif.is_open()) {
+        std::cout << "error opening " << ruta << '\n';
+        return -1;
+    }
+
+    std::vector<std::string> etiquetas, nombres;
+    std::map<std::string, std::map<std::string, double> > medianas;
+    std::string linea;
+
+    while (std::getline(mif, linea)) {
+        if (linea.empty() || linea.compare(0, 9, "etiqueta,") == 0)
+            continue;
+
+        std::istringstream campos(linea);
+        std::string etiqueta, nombre, repeticiones, mediana;
+        std::getline(campos, etiqueta, ',');
+        std::getline(campos, nombre, ',');
+        std::getline(campos, repeticiones, ',');
+        std::getline(campos, mediana, ',');
+
+        if (std::find(etiquetas.begin(), etiquetas.end(), etiqueta) == etiquetas.end())
+            etiquetas.push_back(etiqueta);
+        if (std::find(nombres.begin(), nombres.end(), nombre) == nombres.end())
+            nombres.push_back(nombre);
+        try {
+            medianas[nombre][etiqueta] = std::stod(mediana);
+        } catch (std::invalid_argument const&) {
+            std::cout << "error parsing the median of line: " << linea << '\n';
+            return -1;
+        } catch (std::out_of_range const&) {
+            std::cout << "the median is out of range in line: " << linea << '\n';
+            return -1;
+        }
+    }
+
+    mif.close();
+
+    // Sin filas de datos no hay compilación de referencia con la que comparar.
+    if (etiquetas.empty()) {
+        std::cout << "no results found in " << ruta << '\n';
+        return -1;
+    }
+
+    std::cout << "Mediana de cada núcleo (s) y aceleración respecto a " << etiquetas.front() << ":\n"
+              << std::left << std::setw(24) << "núcleo" << std::right;
+    for (std::string const& e : etiquetas)
+        std::cout << std::setw(20) << e;
+    std::cout << "\n";
+
+    for (std::string const& n : nombres) {
+        std::cout << std::left << std::setw(24) << n << std::right;
+        double base = medianas[n].count(etiquetas.front()) ? medianas[n][etiquetas.front()] : 0;
+        for (std::string const& e : etiquetas) {
+            if (!medianas[n].count(e)) {
+                std::cout << std::setw(20) << "-";
+                continue;
+            }
+            std::ostringstream celda;
+            celda << std::setprecision(4) << medianas[n][e];
+            if (base > 0)
+                celda << " (x" << std::setprecision(3) << base / medianas[n][e] << ")";
+            std::cout << std::setw(20) << celda.str();
+        }
+        std::cout << "\n";
+    }
+
+    return 0;
+}
+
+/*
+ * Punto de entrada del arnés. Entiende los argumentos:
+ *  --warmup W: Repeticiones de calentamiento por núcleo. Por defecto `2`.
+ *  --reps R: Repeticiones medidas por núcleo. Por defecto `10`.
+ *  --formato F: `texto` (por defecto), `json` o `csv`.
+ *  --etiqueta E: Nombre de la compilación (e.g. `O2`) que acompaña a los resultados.
+ *  --filtro T: Solo ejecuta los núcleos cuyo nombre contiene `T`.
+ *  --compara CSV: No mide nada; muestra una tabla comparando los resultados de `CSV`.
+ */
+int ejecutaBenchmarks(int argc, char** argv) {
+    int calentamiento = 2, repeticiones = 10;
+    std::string formato = "texto", etiqueta = "?", filtro;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        try {
+            if (arg == "--warmup" && i + 1 < argc) {
+                calentamiento = std::stoi(argv[++i]);
+            } else if (arg == "--reps" && i + 1 < argc) {
+                repeticiones = std::max(1, std::stoi(argv[++i]));
+            } else if (arg == "--formato" && i + 1 < argc) {
+                formato = argv[++i];
+                if (formato != "texto" && formato != "json" && formato != "csv") {
+                    std::cout << "unknown format: " << formato << '\n';
+                    return -1;
+                }
+            } else if (arg == "--etiqueta" && i + 1 < argc) {
+                etiqueta = argv[++i];
+            } else if (arg == "--filtro" && i + 1 < argc) {
+                filtro = argv[++i];
+            } else if (arg == "--compara" && i + 1 < argc) {
+                return comparaCsv(argv[++i]);
+            } else {
+                std::cout << "usage: " << argv[0] << " [--warmup W] [--reps R] [--formato texto|json|csv] "
+                          << "[--etiqueta E] [--filtro T] [--compara CSV]\n";
+                return -1;
+            }
+        } catch (std::invalid_argument const& ex) {
+            std::cout << "error parsing the input arguments: " << ex.what() << '\n';
+            return -1;
+        } catch (std::out_of_range const& ex) {
+            std::cout << "the input arguments are out of range: " << ex.what() << '\n';
+            return -1;
+        }
+    }
+
+    std::vector<ResultadoBenchmark> resultados;
+    for (Benchmark const& b : benchmarks())
+        if (b.nombre.find(filtro) != std::string::npos)
+            resultados.push_back(mideBenchmark(b, calentamiento, repeticiones));
+
+    if (formato == "json")
+        muestraJson(resultados, etiqueta);
+    else if (formato == "csv")
+        muestraCsv(resultados, etiqueta);
+    else
+        muestraTexto(resultados, etiqueta);
+
+    return 0;
+}
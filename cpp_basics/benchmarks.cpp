@@ -0,0 +1,106 @@
+/*
+ * Este programa registra como «núcleos» los bucles de varios ejemplos del
+ * repositorio y los mide con el arnés de `benchmark.cpp`. Los tamaños son menores
+ * que los originales (e.g. `optimiza.cpp` itera 2000000000 veces) para poder
+ * repetir cada medida varias veces en un tiempo razonable.
+ *
+ * El objetivo `test-benchmarks` del `Makefile` compila este programa con
+ * `-O0`, `-O2`, `-O3` y `-O3 -march=native` y muestra una tabla comparando
+ * los tiempos de cada compilación.
+ */
+
+/*
+ * Define `double sin(double)`, `double exp(double)` y `double sqrt(double)`.
+ * Más información -> https://en.cppreference.com/w/cpp/header/cmath
+ */
+#include <cmath>
+
+/*
+ * Define `std::vector`, donde guardamos los vectores del producto escalar.
+ * Más información -> https://en.cppreference.com/w/cpp/header/vector
+ */
+#include <vector>
+
+#include "benchmark.cpp"
+#include "sumas.cpp"
+
+// Incluimos directamente los núcleos de los ejemplos de funciones y punteros.
+#include "../funcs_n_ptrs/integral/integral.cpp"
+#include "../funcs_n_ptrs/prodEscalar/prodEscalar.cpp"
+
+// Iteraciones de los sumatorios, intervalos de la integral y dimensión de los vectores.
+#define N_SUMA 20000000
+#define N_INTERVALOS 10000000
+#define DIM 1000000
+
+// El integrando de `testIntegral.cpp`.
+double integrando(double x) {
+    return x * exp(-x);
+}
+
+int main(int argc, char** argv) {
+    // El primer bucle de `optimiza.cpp`.
+    registraBenchmark("optimiza/pi_i", []() {
+        double suma = 0, pi = acos(-1);
+        for (int i = 1; i <= N_SUMA; i += 1)
+            suma = suma + pi / double(i);
+        noOptimizar(suma);
+    });
+
+    // El segundo, con `sqrt(pi)` dentro del bucle tal y como está escrito en el original.
+    registraBenchmark("optimiza/sqrtpi_i", []() {
+        double suma = 0, pi = acos(-1);
+        for (int i = 1; i <= N_SUMA; i++)
+            suma += sqrt(pi) / i;
+        noOptimizar(suma);
+    });
+
+    // El sumatorio de `sumatorio.cpp` con cada uno de los modos de `sumas.cpp`.
+    ModoSuma modos[] = {SUMA_INGENUA, SUMA_KAHAN, SUMA_NEUMAIER, SUMA_PAREADA};
+    for (ModoSuma modo : modos) {
+        registraBenchmark(std::string("sumatorio/") + nombreModoSuma(modo), [modo]() {
+            double x = 6.2;
+            noOptimizar(sumaConModo([x](long i) { return x / double(i); }, 1, N_SUMA, modo));
+        });
+    }
+
+    /*
+     * El productorio de `productorio.cpp` tiene solo 10 factores: lo repetimos con
+     * valores de `x` ligeramente distintos para que el compilador no pueda
+     * calcularlo una única vez.
+     */
+    registraBenchmark("productorio", []() {
+        for (int r = 0; r < N_SUMA / 10; r++) {
+            double x = 6.2 + r * 1e-9, prod = 1;
+            for (int i = 1; i <= 10; i++)
+                prod *= sin(x / double(i));
+            noOptimizar(prod);
+        }
+    });
+
+    registraBenchmark("integral", []() {
+        noOptimizar(integral(integrando, 2.0, 3.0, N_INTERVALOS));
+    });
+
+    /*
+     * Los vectores se crean una única vez fuera del núcleo: solo queremos medir el
+     * producto escalar, no la reserva de memoria.
+     */
+    static std::vector<double> v(DIM), w(DIM);
+    for (int i = 0; i < DIM; i++) {
+        v[i] = 1.0 / (i + 1);
+        w[i] = i % 7;
+    }
+
+    registraBenchmark("prodEscalar/valor", []() {
+        noOptimizar(prodEscalar(v.data(), w.data(), DIM));
+    });
+
+    registraBenchmark("prodEscalar/referencia", []() {
+        double resultado;
+        prodescalar(v.data(), w.data(), DIM, resultado);
+        noOptimizar(resultado);
+    });
+
+    return ejecutaBenchmarks(argc, argv);
+}
@@ -0,0 +1,178 @@
+/*
+ * Este programa genera tablas como la de `creaDatos.cpp` (i.e. `parabola.txt`) pero
+ * pensando en cientos de millones de filas: `x` se calcula a partir de un índice
+ * entero, los números se convierten a texto con `std::to_chars()` y la salida se
+ * escribe por bloques. También puede generar la tabla en un formato binario por
+ * columnas. Toda la lógica está en `generadorTabla.cpp`.
+ *
+ * Uso: ./creaDatosRapido.ex [--desde A] [--hasta B] [--paso P] [--columnas C1,C2,...]
+ *                           [--formato texto|binario] [-o salida]
+ *  --desde A, --hasta B, --paso P: Valores de `x` en `[A, B]` separados por `P`. Por
+ *                                  defecto `1`, `9` y `1`, como en `creaDatos.cpp`.
+ *  --columnas: Columnas a generar de entre `x`, `x2`, `x3`, `uno`, `sqrt`, `exp`,
+ *              `log`, `sin` y `cos`. Por defecto `x,x2,uno`, es decir, `x x^2 D`.
+ *  --formato: `texto` (por defecto) o `binario`.
+ *  -o salida: Por defecto `parabola.txt` o `parabola.bin` según el formato; con `-` se
+ *             escribe a `stdout`.
+ */
+
+/*
+ * Define `std::cout` para escribir a pantalla (i.e. `stdout`) y `std::cerr` para
+ * mostrar la velocidad por la salida de errores (i.e. `stderr`).
+ * Más información -> https://en.cppreference.com/w/cpp/header/iostream
+ */
+#include <iostream>
+
+/*
+ * Define `std::string` y `std::stod()` para leer los argumentos.
+ * Más información -> https://en.cppreference.com/w/cpp/header/string
+ */
+#include <string>
+
+/*
+ * Define `std::vector`, donde guardamos las columnas pedidas.
+ * Más información -> https://en.cppreference.com/w/cpp/header/vector
+ */
+#include <vector>
+
+/*
+ * Define `std::chrono::steady_clock` para calcular las filas por segundo.
+ * Más información -> https://en.cppreference.com/w/cpp/header/chrono
+ */
+#include <chrono>
+
+/*
+ * Define `std::istringstream` para separar la lista de columnas por comas.
+ * Más información -> https://en.cppreference.com/w/cpp/header/sstream
+ */
+#include <sstream>
+
+#include "generadorTabla.cpp"
+
+using namespace std;
+
+double identidad(double x) {
+    return x;
+}
+
+double cuadrado(double x) {
+    return x * x;
+}
+
+double cubo(double x) {
+    return x * x * x;
+}
+
+double uno(double) {
+    return 1;
+}
+
+/*
+ * Busca la función asociada a un nombre de columna. Las funciones de `<cmath>` están
+ * sobrecargadas (e.g. hay un `sqrt` para `float` y otro para `double`), con lo que
+ * tenemos que indicar cuál queremos convirtiéndolas explícitamente al tipo del puntero.
+ */
+bool buscaColumna(string const& nombre, Columna& c) {
+    typedef double (*Funcion)(double);
+    const char* nombres[] = {"x", "x2", "x3", "uno", "sqrt", "exp", "log", "sin", "cos"};
+    Funcion funciones[] = {identidad, cuadrado, cubo, uno, (Funcion) sqrt, (Funcion) exp,
+                           (Funcion) log, (Funcion) sin, (Funcion) cos};
+    for (int i = 0; i < 9; i++) {
+        if (nombre == nombres[i]) {
+            c.nombre = nombre;
+            c.f = funciones[i];
+            return true;
+        }
+    }
+    return false;
+}
+
+int main(int argc, char** argv) {
+    double desde = 1, hasta = 9, paso = 1;
+    string columnas = "x,x2,uno", formato = "texto", salida;
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        try {
+            if (arg == "--desde" && i + 1 < argc) {
+                desde = stod(argv[++i]);
+            } else if (arg == "--hasta" && i + 1 < argc) {
+                hasta = stod(argv[++i]);
+            } else if (arg == "--paso" && i + 1 < argc) {
+                paso = stod(argv[++i]);
+            } else if (arg == "--columnas" && i + 1 < argc) {
+                columnas = argv[++i];
+            } else if (arg == "--formato" && i + 1 < argc) {
+                formato = argv[++i];
+            } else if (arg == "-o" && i + 1 < argc) {
+                salida = argv[++i];
+            } else {
+                cout << "usage: " << argv[0] << " [--desde A] [--hasta B] [--paso P] [--columnas C1,C2,...] "
+                     << "[--formato texto|binario] [-o salida]\n";
+                return -1;
+            }
+        } catch (invalid_argument const& ex) {
+            cout << "error parsing the input arguments: " << ex.what() << '\n';
+            return -1;
+        } catch (out_of_range const& ex) {
+            cout << "the input arguments are out of range: " << ex.what() << '\n';
+            return -1;
+        }
+    }
+
+    if (formato != "texto" && formato != "binario") {
+        cout << "unknown format: " << formato << '\n';
+        return -1;
+    }
+    if (salida.empty())
+        salida = formato == "texto" ? "parabola.txt" : "parabola.bin";
+
+    vector<Columna> tabla;
+    istringstream nombres(columnas);
+    string nombre;
+    while (getline(nombres, nombre, ',')) {
+        Columna c;
+        if (!buscaColumna(nombre, c)) {
+            cout << "unknown column: " << nombre << '\n';
+            return -1;
+        }
+        tabla.push_back(c);
+    }
+
+    RangoTabla rango;
+    if (!rangoTabla(desde, hasta, paso, rango)) {
+        if (paso == 0)
+            cout << "the step MUST be non-zero\n";
+        else
+            cout << "too many rows: at most " << TABLA_MAX_FILAS << " can be generated\n";
+        cout << "usage: " << argv[0] << " [--desde A] [--hasta B] [--paso P] [--columnas C1,C2,...] "
+             << "[--formato texto|binario] [-o salida]\n";
+        return -1;
+    }
+
+    int fd = salida == "-" ? STDOUT_FILENO : open(salida.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        cout << "error opening " << salida << '\n';
+        return -1;
+    }
+
+    EscritorBuffer escritor = creaEscritor(fd);
+
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    bool ok = formato == "texto" ? escribeTablaTexto(escritor, rango, tabla) : escribeTablaBinaria(escritor, rango, tabla);
+    chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+
+    if (fd != STDOUT_FILENO)
+        close(fd);
+
+    if (!ok) {
+        cout << "error writing " << salida << '\n';
+        return -1;
+    }
+
+    double segundos = chrono::duration<double>(t1 - t0).count();
+    cerr << "Generadas " << rango.filas << " filas (" << escritor.bytesEscritos << " bytes) en " << segundos
+         << " s (" << (segundos > 0 ? rango.filas / segundos : 0) << " filas/s)\n";
+
+    return 0;
+}
@@ -67,34 +67,28 @@ int main() {
      * palabra del flujo asociado al archivo de entrada. El operador
      * `>>` extrae palabras ya que, por defecto, detiene su acción
      * al encontrar espacio en blanco en el flujo.
-     */
-    mif >> palabra;
-
-    /*
-     * Como queremos leer todo el archivo, iteraremos con la condición
-     * de haber llegado hasta el final del mismo. Dado que los archivos
-     * se presentan como una sucesión de caracteres somos conscientes de
-     * que, al leerlo, eventualmente llegaremos al final del mismo. Cuando
-     * ese evento tiene lugar decimos que hemos llegado al EOF (i.e. End
-     * of File) del archivo. Dada su utilidad, la instancia del flujo
-     * asociado al archivo (i.e. `mif`) cuenta con una función que nos
-     * indica justamente si hemos leído el archivo completo o no. La función
-     * devuelve un booleano (i.e. `bool`) que será verdadero si hemos leído
-     * todo el archivo y falso si todavía nos queda algo por leer. Dado que
-     * el bucle se detiene cuando la condición de control es falsa y que
-     * nosotros queremos detener el bucle cuando `eof()` sea verdadero, tenemos
-     * que «invertir» el valor devuelto por `eof()` con el operador lógico
-     * de negación (i.e. `!`). Por tanto, la condición del bucle se leería
-     * como: «itera mientras no hayamos llegado al EOF del archivo». Podéis
-     * encontrar más información del método `eof()` en:
+     *
+     * Como queremos leer todo el archivo, iteraremos mientras sigamos siendo
+     * capaces de extraer palabras. La expresión `mif >> palabra` devuelve el
+     * propio flujo, que al usarse como condición se convierte en un booleano
+     * (i.e. `bool`): será verdadero si la extracción ha tenido éxito y falso si
+     * ha fallado, por ejemplo porque ya hemos llegado al final del archivo (i.e.
+     * al EOF, End of File). Por tanto, la condición del bucle se leería como:
+     * «itera mientras hayas podido leer una palabra».
+     *
+     * Podríamos caer en la tentación de controlar el bucle con la función `eof()`
+     * del flujo (i.e. `while (!mif.eof())`), que nos indica si hemos llegado al
+     * final del archivo. Sin embargo, `eof()` solo se activa **después** de que
+     * una lectura haya fallado por llegar al final: si el archivo termina con un
+     * salto de línea contaríamos una palabra de más (la lectura fallida) y si no
+     * termina con él, una de menos. Comprobar el resultado de la propia extracción
+     * evita el problema. Podéis encontrar más información en:
      *  https://en.cppreference.com/w/cpp/io/basic_ios/eof
+     *  https://en.cppreference.com/w/cpp/io/basic_ios/operator_bool
      */
-    while (!mif.eof()) {
-        // Mientras quede archivo por leer seguimos extrayendo palabras...
-        mif >> palabra;
-
+    while (mif >> palabra) {
         /*
-         * Y cada vez que extraigamos una vamos actualizando la cuenta total.
+         * Cada vez que extraigamos una palabra vamos actualizando la cuenta total.
          * Nótese que este incremento podría haberse hecho de otras maneras:
          *  n_palabras = n_palabras + 1;
          *  n_palabras += 1;
@@ -0,0 +1,93 @@
+/*
+ * Este programa cuenta las palabras de un archivo como `cuentaPalabras.cpp`, pero
+ * pensando en archivos de varios GB: proyecta el archivo en memoria con `mmap(2)`,
+ * cuenta las palabras sin extraerlas a `std::string`s, clasifica los bytes con
+ * instrucciones vectoriales y puede repartir el archivo entre varios hilos. Toda
+ * la lógica está en `contadorPalabras.cpp`.
+ *
+ * Uso: ./cuentaPalabrasRapido.ex [--threads N] [archivo]
+ *  --threads N: Número de hilos a emplear. Con `0` (por defecto) se usan todos los núcleos.
+ *  archivo: Archivo a contar. Por defecto `libro.txt`; con `-` se lee la entrada estándar,
+ *           e.g. `cat libro.txt | ./cuentaPalabrasRapido.ex -`.
+ */
+
+/*
+ * Define `std::cout` para escribir a pantalla (i.e. `stdout`).
+ * Más información -> https://en.cppreference.com/w/cpp/header/iostream
+ */
+#include <iostream>
+
+/*
+ * Define `std::string` y `std::stoi()`.
+ * Más información -> https://en.cppreference.com/w/cpp/header/string
+ */
+#include <string>
+
+/*
+ * Define `std::chrono::steady_clock` para calcular los MB/s procesados.
+ * Más información -> https://en.cppreference.com/w/cpp/header/chrono
+ */
+#include <chrono>
+
+#include "contadorPalabras.cpp"
+
+// Más hilos que esto no tiene sentido ni en las máquinas más grandes.
+#define MAX_HILOS 1024
+
+using namespace std;
+
+int main(int argc, char** argv) {
+    unsigned hilos = 0;
+    string ruta = "libro.txt";
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--threads" && i + 1 < argc) {
+            // Leemos con signo: `-1` guardado directamente en un `unsigned` sería 4294967295 hilos.
+            int leidos;
+            try {
+                leidos = stoi(argv[++i]);
+            } catch (exception const& ex) {
+                cout << "error parsing the number of threads: " << ex.what() << '\n';
+                return -1;
+            }
+            if (leidos < 0 || leidos > MAX_HILOS) {
+                cout << "the number of threads MUST be in [0, " << MAX_HILOS << "]\n";
+                return -1;
+            }
+            hilos = leidos;
+        } else if (arg.size() > 1 && arg[0] == '-') {
+            cout << "usage: " << argv[0] << " [--threads N] [archivo]\n";
+            return -1;
+        } else {
+            ruta = arg;
+        }
+    }
+
+    ArchivoMapeado archivo = abreArchivo(ruta);
+    if (archivo.fd < 0) {
+        cout << "error opening " << ruta << '\n';
+        return -1;
+    }
+
+    size_t bytes;
+    bool mapeado = archivo.datos != NULL;
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    long palabras = cuentaPalabrasArchivo(archivo, hilos, bytes);
+    chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+
+    cierraArchivo(archivo);
+
+    if (palabras < 0) {
+        cout << "error reading " << ruta << '\n';
+        return -1;
+    }
+
+    double segundos = chrono::duration<double>(t1 - t0).count();
+    cout << "Número de palabras = " << palabras << endl;
+    cerr << "Procesados " << bytes << " bytes en " << segundos << " s ("
+         << (segundos > 0 ? bytes / segundos / 1e6 : 0) << " MB/s, "
+         << (mapeado ? "mmap" : "read") << ")\n";
+
+    return 0;
+}
@@ -0,0 +1,53 @@
+/*
+ * Este programa cuenta las palabras de un archivo igual que `cuentaPalabras.cpp`,
+ * pero es una simple configuración de la tubería de `tuberiaTexto.cpp`: el filtro
+ * rechaza todas las palabras (no queremos escribir ninguna) y la tubería se limita
+ * a contarlas. Al terminar muestra las estadísticas de cada etapa y cola por `stderr`.
+ *
+ * Uso: ./cuentaPalabrasTuberia.ex [archivo]
+ *  archivo: Archivo a contar. Por defecto `libro.txt`; con `-` se lee la entrada estándar.
+ */
+
+/*
+ * Define `std::cout` para escribir a pantalla (i.e. `stdout`) y `std::cerr` para
+ * mostrar las estadísticas de la tubería por la salida de errores (i.e. `stderr`).
+ * Más información -> https://en.cppreference.com/w/cpp/header/iostream
+ */
+#include <iostream>
+
+/*
+ * Define `std::string` para guardar la ruta del archivo.
+ * Más información -> https://en.cppreference.com/w/cpp/header/string
+ */
+#include <string>
+
+#include "tuberiaTexto.cpp"
+
+using namespace std;
+
+int main(int argc, char** argv) {
+    string ruta = argc > 1 ? argv[1] : "libro.txt";
+
+    int fd = ruta == "-" ? STDIN_FILENO : open(ruta.c_str(), O_RDONLY);
+    if (fd < 0) {
+        cout << "error opening " << ruta << '\n';
+        return -1;
+    }
+
+    EstadisticasTuberia est = ejecutaTuberia(configTuberia(fd, -1), [](const char*, size_t, long) {
+        return false;
+    });
+
+    if (fd != STDIN_FILENO)
+        close(fd);
+
+    if (est.error) {
+        cout << "error reading " << ruta << '\n';
+        return -1;
+    }
+
+    cout << "Número de palabras = " << est.palabras << endl;
+    muestraEstadisticas(cerr, est);
+
+    return 0;
+}
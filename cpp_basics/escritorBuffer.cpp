@@ -0,0 +1,131 @@
+/*
+ * Este archivo no contiene un `main()`: define un «escritor» que acumula lo que
+ * queremos escribir en un buffer grande y solo lo entrega al sistema operativo con
+ * `write(2)` cuando se llena. Cada `write()` es una llamada al sistema, mucho más
+ * cara que copiar unos bytes a memoria: escribir una palabra por llamada (que es lo
+ * que ocurre con `fsalida << palabra << endl`, ya que `endl` vacía el flujo) hace
+ * que el programa pase casi todo el tiempo esperando al sistema.
+ *
+ * Si nos piden escribir un fragmento mayor que el espacio libre, en vez de copiarlo
+ * enviamos el contenido del buffer y el fragmento en una única llamada a `writev(2)`.
+ * Más información -> https://www.man7.org/linux/man-pages/man2/writev.2.html
+ */
+
+/*
+ * Define `std::memcpy()` para copiar los fragmentos al buffer.
+ * Más información -> https://en.cppreference.com/w/cpp/header/cstring
+ */
+#include <cstring>
+
+/*
+ * Define `errno` y `EINTR` para reintentar las escrituras interrumpidas por una señal.
+ * Más información -> https://en.cppreference.com/w/cpp/header/cerrno
+ */
+#include <cerrno>
+
+/*
+ * Define `std::vector`, donde vive el buffer.
+ * Más información -> https://en.cppreference.com/w/cpp/header/vector
+ */
+#include <vector>
+
+/*
+ * Estas cabeceras son parte de la interfaz POSIX y no de la librería estándar de
+ * C++: definen `writev()` y `struct iovec`, y `open()` y `close()` para que los
+ * programas que usan el escritor puedan abrir y cerrar el archivo de salida.
+ */
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+// El tamaño por defecto del buffer: 1 MiB.
+#define ESCRITOR_CAPACIDAD (1 << 20)
+
+struct EscritorBuffer {
+    int fd;
+    std::vector<char> buffer;
+    size_t usado;
+    // Estadísticas: bytes entregados al sistema y número de llamadas realizadas.
+    size_t bytesEscritos, llamadas;
+    // Se pone a `true` si alguna escritura falla.
+    bool error;
+};
+
+EscritorBuffer creaEscritor(int fd, size_t capacidad = ESCRITOR_CAPACIDAD) {
+    EscritorBuffer e = {fd, std::vector<char>(capacidad), 0, 0, 0, false};
+    return e;
+}
+
+/*
+ * Escribe los `n` bloques de `iov` completos. `writev()` puede escribir menos de lo
+ * pedido (e.g. en una tubería llena), con lo que avanzamos por los bloques y
+ * repetimos hasta terminar. Tras el primer error no volvemos a escribir: la salida
+ * ya está incompleta y solo añadiríamos trozos sueltos.
+ */
+bool escribeBloques(EscritorBuffer& e, iovec* iov, int n) {
+    if (e.error)
+        return false;
+    while (n > 0) {
+        ssize_t escrito = writev(e.fd, iov, n);
+        if (escrito < 0) {
+            if (errno == EINTR)
+                continue;
+            e.error = true;
+            return false;
+        }
+        e.llamadas++;
+        e.bytesEscritos += escrito;
+
+        while (n > 0 && size_t(escrito) >= iov->iov_len) {
+            escrito -= iov->iov_len;
+            iov++;
+            n--;
+        }
+        if (n > 0) {
+            iov->iov_base = (char*) iov->iov_base + escrito;
+            iov->iov_len -= escrito;
+        }
+    }
+    return true;
+}
+
+/*
+ * Entrega al sistema todo lo acumulado en el buffer. Devuelve `false` si esta o
+ * cualquier escritura anterior ha fallado, así que basta con comprobarla al final.
+ */
+bool vuelcaEscritor(EscritorBuffer& e) {
+    if (e.usado == 0)
+        return !e.error;
+    iovec iov = {e.buffer.data(), e.usado};
+    e.usado = 0;
+    return escribeBloques(e, &iov, 1) && !e.error;
+}
+
+bool escribe(EscritorBuffer& e, const char* datos, size_t n) {
+    if (e.usado + n <= e.buffer.size()) {
+        std::memcpy(e.buffer.data() + e.usado, datos, n);
+        e.usado += n;
+        return true;
+    }
+
+    // Si el fragmento cabe en un buffer vacío vaciamos el actual y lo copiamos.
+    if (n < e.buffer.size()) {
+        if (!vuelcaEscritor(e))
+            return false;
+        std::memcpy(e.buffer.data(), datos, n);
+        e.usado = n;
+        return true;
+    }
+
+    // Si no cabe, lo enviamos junto al buffer en una única llamada sin copiarlo.
+    iovec iov[2] = {{e.buffer.data(), e.usado}, {(void*) datos, n}};
+    e.usado = 0;
+    return escribeBloques(e, iov, 2);
+}
+
+inline bool escribe(EscritorBuffer& e, char c) {
+    if (e.usado == e.buffer.size() && !vuelcaEscritor(e))
+        return false;
+    e.buffer[e.usado++] = c;
+    return true;
+}
@@ -0,0 +1,125 @@
+/*
+ * Este programa va un paso más allá de `cuentaPalabras.cpp`: en vez de contar el
+ * número total de palabras cuenta cuántas veces aparece cada una (sin distinguir
+ * mayúsculas de minúsculas, también en letras como `Á` o `Ñ`) y muestra las más
+ * frecuentes junto con la velocidad de procesado en MB/s. Toda la lógica está en
+ * `tablaFrecuencias.cpp`.
+ *
+ * Uso: ./frecuenciaPalabras.ex [--threads N] [--top K] [archivo]
+ *  --threads N: Número de hilos a emplear. Con `0` (por defecto) se usan todos los núcleos.
+ *  --top K: Número de palabras a mostrar. Por defecto `10`.
+ *  archivo: Archivo a analizar. Por defecto `libro.txt`; con `-` se lee la entrada estándar.
+ */
+
+/*
+ * Define `std::cout` para escribir a pantalla (i.e. `stdout`) y `std::cerr` para
+ * mostrar la velocidad por la salida de errores (i.e. `stderr`).
+ * Más información -> https://en.cppreference.com/w/cpp/header/iostream
+ */
+#include <iostream>
+
+/*
+ * Define `std::string`, `std::stoi()` y `std::to_string()` para leer los argumentos.
+ * Más información -> https://en.cppreference.com/w/cpp/header/string
+ */
+#include <string>
+
+/*
+ * Define `std::vector`, donde copiamos la entrada estándar y guardamos las palabras
+ * más frecuentes.
+ * Más información -> https://en.cppreference.com/w/cpp/header/vector
+ */
+#include <vector>
+
+/*
+ * Define `std::chrono::steady_clock` para medir el tiempo del conteo.
+ * Más información -> https://en.cppreference.com/w/cpp/header/chrono
+ */
+#include <chrono>
+
+#include "archivoMapeado.cpp"
+#include "tablaFrecuencias.cpp"
+
+// Más hilos que esto no tiene sentido ni en las máquinas más grandes.
+#define MAX_HILOS 1024
+
+using namespace std;
+
+int main(int argc, char** argv) {
+    unsigned hilos = 0;
+    size_t top = 10;
+    string ruta = "libro.txt";
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        try {
+            if (arg == "--threads" && i + 1 < argc) {
+                // Leemos con signo: `-1` guardado directamente en un `unsigned` sería 4294967295 hilos.
+                int leidos = stoi(argv[++i]);
+                if (leidos < 0 || leidos > MAX_HILOS)
+                    throw invalid_argument("--threads MUST be in [0, " + to_string(MAX_HILOS) + "]");
+                hilos = leidos;
+            } else if (arg == "--top" && i + 1 < argc) {
+                int leidos = stoi(argv[++i]);
+                if (leidos <= 0)
+                    throw invalid_argument("--top MUST be positive");
+                top = leidos;
+            } else if (arg.size() > 1 && arg[0] == '-') {
+                cout << "usage: " << argv[0] << " [--threads N] [--top K] [archivo]\n";
+                return -1;
+            } else {
+                ruta = arg;
+            }
+        } catch (exception const& ex) {
+            cout << "error parsing the input arguments: " << ex.what() << '\n';
+            return -1;
+        }
+    }
+
+    ArchivoMapeado archivo = abreArchivo(ruta);
+    if (archivo.fd < 0) {
+        cout << "error opening " << ruta << '\n';
+        return -1;
+    }
+
+    /*
+     * Las claves de la tabla apuntan al texto, con lo que este debe seguir en
+     * memoria hasta el final. Si no lo hemos podido proyectar (e.g. es una tubería)
+     * lo leemos entero a un `std::vector`.
+     */
+    const char* texto = archivo.datos;
+    size_t tam = archivo.tam;
+    vector<char> copia;
+    if (texto == NULL) {
+        vector<char> bloque(1 << 20);
+        long n;
+        while ((n = leeBloque(archivo, bloque.data(), bloque.size())) > 0)
+            copia.insert(copia.end(), bloque.begin(), bloque.begin() + n);
+        if (n < 0) {
+            cout << "error reading " << ruta << '\n';
+            return -1;
+        }
+        texto = copia.data();
+        tam = copia.size();
+    }
+
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    TablaFrecuencias tabla = cuentaFrecuenciasParalelo(texto, tam, hilos);
+    vector<EntradaFrecuencia> mejores = masFrecuentes(tabla, top);
+    chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+
+    uint64_t total = 0;
+    for (EntradaFrecuencia const& e : tabla.entradas)
+        total += e.cuenta;
+
+    cout << "Palabras = " << total << "; distintas = " << tabla.ocupadas << "\n";
+    for (EntradaFrecuencia const& e : mejores)
+        cout << "\t" << e.cuenta << "\t" << palabraMinusculas(e.palabra, e.len) << "\n";
+
+    double segundos = chrono::duration<double>(t1 - t0).count();
+    cerr << "Procesados " << tam << " bytes en " << segundos << " s ("
+         << (segundos > 0 ? tam / segundos / 1e6 : 0) << " MB/s)\n";
+
+    cierraArchivo(archivo);
+    return 0;
+}
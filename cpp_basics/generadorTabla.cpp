@@ -0,0 +1,196 @@
+/*
+ * Este archivo no contiene un `main()`: genera tablas de datos como la de
+ * `creaDatos.cpp` (i.e. `x x^2 D`) pensando en cientos de millones de filas:
+ *
+ *  - La variable `x` no se acumula sumando el paso (`x = x + 1`), que arrastra un
+ *    error de redondeo en cada iteración, sino que se calcula a partir del índice
+ *    entero de la fila: `x = inicio + i * paso`.
+ *  - Cada columna es una función `double f(double x)` que nos pasan como puntero,
+ *    igual que en los ejemplos de `funcs_n_ptrs`.
+ *  - Los números se convierten a texto con `std::to_chars()` (C++17), que genera la
+ *    representación más corta que, al volver a leerla, da exactamente el mismo
+ *    `double`. Es muchísimo más rápido que el formateo de los flujos (`<<`) y escribe
+ *    directamente a un buffer (ver `escritorBuffer.cpp`).
+ *    Más información -> https://en.cppreference.com/w/cpp/utility/to_chars
+ *  - Como alternativa, la tabla se puede escribir en un formato binario «por
+ *    columnas» que no hay que convertir a texto ni volver a interpretar al leerlo.
+ *
+ * Formato binario (todos los enteros en el orden de bytes de la máquina):
+ *  - Cabecera de 24 bytes: la «firma» `COLUMNAS` (8 bytes), la versión (`uint32_t`, 1),
+ *    el número de columnas (`uint32_t`) y el número de filas (`uint64_t`).
+ *  - El nombre de cada columna en 32 bytes rellenos con `'\0'`.
+ *  - Los datos de cada columna, uno tras otro, como `filas` `double`s consecutivos.
+ *    Cada columna empieza en una posición múltiplo de 64 bytes para que al proyectar
+ *    el archivo en memoria las columnas queden alineadas para instrucciones vectoriales.
+ */
+
+/*
+ * Define `std::to_chars()`.
+ * Más información -> https://en.cppreference.com/w/cpp/header/charconv
+ */
+#include <charconv>
+
+/*
+ * Define `std::min()`.
+ * Más información -> https://en.cppreference.com/w/cpp/header/algorithm
+ */
+#include <algorithm>
+
+/*
+ * Define `std::floor()` y `std::isfinite()` para calcular el número de filas.
+ * Más información -> https://en.cppreference.com/w/cpp/header/cmath
+ */
+#include <cmath>
+
+/*
+ * Define `uint32_t` y `uint64_t`, enteros con un tamaño garantizado para la cabecera binaria.
+ * Más información -> https://en.cppreference.com/w/cpp/header/cstdint
+ */
+#include <cstdint>
+
+/*
+ * Define `std::memcpy()` y `std::strncpy()` para rellenar la cabecera binaria.
+ * Más información -> https://en.cppreference.com/w/cpp/header/cstring
+ */
+#include <cstring>
+
+/*
+ * Define `std::string`, el nombre de cada columna.
+ * Más información -> https://en.cppreference.com/w/cpp/header/string
+ */
+#include <string>
+
+/*
+ * Define `std::vector`, donde guardamos las columnas y el texto de cada fila.
+ * Más información -> https://en.cppreference.com/w/cpp/header/vector
+ */
+#include <vector>
+
+#include "escritorBuffer.cpp"
+
+#define COLUMNAS_FIRMA "COLUMNAS"
+#define COLUMNAS_VERSION 1
+#define COLUMNAS_NOMBRE 32
+#define COLUMNAS_ALINEACION 64
+
+// Un billón de filas: unos 8 TB por columna en binario.
+#define TABLA_MAX_FILAS (uint64_t(1) << 40)
+
+struct CabeceraColumnas {
+    char firma[8];
+    uint32_t version, columnas;
+    uint64_t filas;
+};
+
+struct Columna {
+    std::string nombre;
+    double (*f)(double);
+};
+
+/*
+ * El rango de valores de `x`: `filas` valores empezando en `inicio` y separados por
+ * `paso`. Al usar un índice entero el número de filas es exacto, sea cual sea el paso.
+ */
+struct RangoTabla {
+    double inicio, paso;
+    uint64_t filas;
+};
+
+/*
+ * Construye el rango `[inicio, fin]` con el paso indicado. Toleramos una pequeña
+ * diferencia para que, por ejemplo, `0.1` a `0.3` con paso `0.1` incluya el `0.3`
+ * aunque `(0.3 - 0.1) / 0.1` sea `1.9999999999999998`.
+ *
+ * Devuelve `false` si el paso es `0` o si el número de filas no es finito o supera
+ * `TABLA_MAX_FILAS` (e.g. un paso de `1e-300`): convertir ese `double` a `uint64_t`
+ * no está definido.
+ */
+bool rangoTabla(double inicio, double fin, double paso, RangoTabla& r) {
+    r = {inicio, paso, 0};
+    if (paso == 0)
+        return false;
+    double n = (fin - inicio) / paso;
+    if (!std::isfinite(n) || n + 1 > double(TABLA_MAX_FILAS))
+        return false;
+    if (n >= -1e-9)
+        r.filas = uint64_t(std::floor(n + 1e-9)) + 1;
+    return true;
+}
+
+inline double valorX(RangoTabla const& r, uint64_t i) {
+    return r.inicio + double(i) * r.paso;
+}
+
+/*
+ * Escribe la tabla como texto: una fila por línea con las columnas separadas por un
+ * espacio. Cada fila se formatea en un pequeño array y luego se copia al buffer del
+ * escritor, que solo hace una llamada a `write()` cada 1 MiB.
+ */
+bool escribeTablaTexto(EscritorBuffer& e, RangoTabla const& r, std::vector<Columna> const& columnas) {
+    // Un `double` ocupa como mucho 24 caracteres en su forma más corta.
+    std::vector<char> fila(columnas.size() * 25 + 1);
+
+    for (uint64_t i = 0; i < r.filas; i++) {
+        double x = valorX(r, i);
+        char *p = fila.data(), *fin = fila.data() + fila.size();
+        for (size_t c = 0; c < columnas.size(); c++) {
+            if (c > 0)
+                *p++ = ' ';
+            p = std::to_chars(p, fin, columnas[c].f(x)).ptr;
+        }
+        *p++ = '\n';
+        if (!escribe(e, fila.data(), p - fila.data()))
+            return false;
+    }
+
+    return vuelcaEscritor(e);
+}
+
+// Escribe `n` bytes a cero para alinear la siguiente columna.
+bool rellena(EscritorBuffer& e, size_t n) {
+    static const char ceros[COLUMNAS_ALINEACION] = {0};
+    return escribe(e, ceros, n);
+}
+
+// Bytes de relleno necesarios para que la posición `pos` sea múltiplo de la alineación.
+inline size_t relleno(size_t pos) {
+    return (COLUMNAS_ALINEACION - pos % COLUMNAS_ALINEACION) % COLUMNAS_ALINEACION;
+}
+
+/*
+ * Escribe la tabla en el formato binario por columnas descrito al principio del
+ * archivo. Calculamos cada columna de principio a fin, con lo que la misma función
+ * se llama en un bucle apretado y los valores se copian en bloque al buffer.
+ */
+bool escribeTablaBinaria(EscritorBuffer& e, RangoTabla const& r, std::vector<Columna> const& columnas) {
+    CabeceraColumnas cab;
+    std::memcpy(cab.firma, COLUMNAS_FIRMA, sizeof(cab.firma));
+    cab.version = COLUMNAS_VERSION;
+    cab.columnas = columnas.size();
+    cab.filas = r.filas;
+
+    size_t pos = sizeof(cab);
+    bool ok = escribe(e, (const char*) &cab, sizeof(cab));
+    for (Columna const& c : columnas) {
+        char nombre[COLUMNAS_NOMBRE] = {0};
+        std::strncpy(nombre, c.nombre.c_str(), COLUMNAS_NOMBRE - 1);
+        ok = ok && escribe(e, nombre, COLUMNAS_NOMBRE);
+        pos += COLUMNAS_NOMBRE;
+    }
+
+    const size_t BLOQUE = 4096;
+    double valores[BLOQUE];
+    for (Columna const& c : columnas) {
+        ok = ok && rellena(e, relleno(pos));
+        pos += relleno(pos);
+        for (uint64_t i = 0; ok && i < r.filas; i += BLOQUE) {
+            size_t n = std::min<uint64_t>(BLOQUE, r.filas - i);
+            for (size_t k = 0; k < n; k++)
+                valores[k] = c.f(valorX(r, i + k));
+            ok = escribe(e, (const char*) valores, n * sizeof(double));
+        }
+        pos += r.filas * sizeof(double);
+    }
+
+    return ok && vuelcaEscritor(e);
+}
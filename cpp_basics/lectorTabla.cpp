@@ -0,0 +1,211 @@
+/*
+ * Este archivo no contiene un `main()`: lee tablas de datos como `parabola.txt` (ver
+ * `creaDatos.cpp` y `creaDatosRapido.cpp`) y deja cada columna en un array de
+ * `double`s contiguo, es decir, como una «estructura de arrays» y no como un array
+ * de filas. Así los cálculos que recorren una columna entera (integrales, productos
+ * escalares...) leen memoria consecutiva y el compilador puede vectorizarlos.
+ *
+ *  - Las tablas en texto se interpretan con `std::from_chars()` (C++17), que no
+ *    depende de la configuración regional ni de flujos y es muchísimo más rápido que
+ *    `misdat >> x`. El archivo se proyecta en memoria (ver `archivoMapeado.cpp`) y
+ *    los números se leen directamente de él.
+ *    Más información -> https://en.cppreference.com/w/cpp/utility/from_chars
+ *  - Las tablas en el formato binario de `generadorTabla.cpp` ya están guardadas por
+ *    columnas, con lo que basta con proyectar el archivo y apuntar a cada columna:
+ *    no se copia ni se convierte ni un solo byte.
+ */
+
+/*
+ * Define `std::from_chars()`.
+ * Más información -> https://en.cppreference.com/w/cpp/header/charconv
+ */
+#include <charconv>
+
+/*
+ * Define `uint32_t` y `uint64_t`, los enteros de la cabecera del formato binario.
+ * Más información -> https://en.cppreference.com/w/cpp/header/cstdint
+ */
+#include <cstdint>
+
+/*
+ * Define `std::memcpy()`, `std::memcmp()` y `strnlen()` para leer la cabecera binaria.
+ * Más información -> https://en.cppreference.com/w/cpp/header/cstring
+ */
+#include <cstring>
+
+/*
+ * Define `std::string`, el nombre de cada columna.
+ * Más información -> https://en.cppreference.com/w/cpp/header/string
+ */
+#include <string>
+
+/*
+ * Define `std::vector`, donde guardamos los valores de las tablas en texto.
+ * Más información -> https://en.cppreference.com/w/cpp/header/vector
+ */
+#include <vector>
+
+#include "archivoMapeado.cpp"
+// También incluye `escritorBuffer.cpp`. Lo necesitamos por la cabecera del formato binario.
+#include "generadorTabla.cpp"
+
+struct TablaColumnas {
+    std::vector<std::string> nombres;
+    uint64_t filas;
+    // Un puntero al comienzo de cada columna, ya sea dentro del archivo proyectado o de `datos`.
+    std::vector<const double*> columnas;
+    // Los valores leídos de una tabla en texto; vacío si la tabla es binaria.
+    std::vector<std::vector<double>> datos;
+    // El archivo del que hemos leído la tabla: en las tablas binarias las columnas apuntan a él.
+    ArchivoMapeado archivo;
+    // Descripción del problema si no se ha podido leer la tabla.
+    std::string error;
+};
+
+inline bool esBlanco(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+/*
+ * Interpreta una tabla en texto: una fila por línea con los valores separados por
+ * espacios o tabuladores. El número de columnas es el de la primera fila con datos
+ * y todas las demás deben tener el mismo. Las líneas vacías se ignoran.
+ */
+bool leeTablaTexto(const char* texto, size_t tam, TablaColumnas& t) {
+    const char *p = texto, *fin = texto + tam;
+    uint64_t linea = 0;
+    std::vector<double> fila;
+
+    while (p < fin) {
+        linea++;
+        fila.clear();
+        while (true) {
+            while (p < fin && esBlanco(*p))
+                p++;
+            if (p == fin || *p == '\n')
+                break;
+            double v;
+            std::from_chars_result r = std::from_chars(p, fin, v);
+            if (r.ec != std::errc() || (r.ptr < fin && !esBlanco(*r.ptr) && *r.ptr != '\n')) {
+                t.error = "invalid number at line " + std::to_string(linea);
+                return false;
+            }
+            fila.push_back(v);
+            p = r.ptr;
+        }
+        p++;
+
+        if (fila.empty())
+            continue;
+        if (t.datos.empty()) {
+            t.datos.resize(fila.size());
+            for (size_t c = 0; c < fila.size(); c++)
+                t.nombres.push_back("c" + std::to_string(c + 1));
+        } else if (fila.size() != t.datos.size()) {
+            t.error = "wrong number of columns at line " + std::to_string(linea);
+            return false;
+        }
+        for (size_t c = 0; c < fila.size(); c++)
+            t.datos[c].push_back(fila[c]);
+    }
+
+    t.filas = t.datos.empty() ? 0 : t.datos[0].size();
+    for (std::vector<double> const& c : t.datos)
+        t.columnas.push_back(c.data());
+    return true;
+}
+
+/*
+ * «Lee» una tabla binaria proyectada: comprobamos la cabecera y que el archivo sea lo
+ * bastante grande y calculamos dónde empieza cada columna, igual que al escribirla.
+ * Como `mmap()` devuelve direcciones alineadas a una página, las columnas quedan
+ * alineadas a 64 bytes también en memoria.
+ */
+bool leeTablaBinaria(const char* datos, size_t tam, TablaColumnas& t) {
+    CabeceraColumnas cab;
+    if (tam < sizeof(cab)) {
+        t.error = "truncated header";
+        return false;
+    }
+    std::memcpy(&cab, datos, sizeof(cab));
+    if (std::memcmp(cab.firma, COLUMNAS_FIRMA, sizeof(cab.firma)) != 0 || cab.version != COLUMNAS_VERSION) {
+        t.error = "unknown binary format";
+        return false;
+    }
+
+    size_t pos = sizeof(cab) + size_t(cab.columnas) * COLUMNAS_NOMBRE;
+    if (tam < pos) {
+        t.error = "truncated header";
+        return false;
+    }
+    for (uint32_t c = 0; c < cab.columnas; c++) {
+        const char* nombre = datos + sizeof(cab) + c * COLUMNAS_NOMBRE;
+        t.nombres.push_back(std::string(nombre, strnlen(nombre, COLUMNAS_NOMBRE)));
+    }
+
+    for (uint32_t c = 0; c < cab.columnas; c++) {
+        pos += relleno(pos);
+        if (cab.filas > (tam - std::min(pos, tam)) / sizeof(double)) {
+            t.error = "truncated column " + t.nombres[c];
+            return false;
+        }
+        t.columnas.push_back((const double*) (datos + pos));
+        pos += cab.filas * sizeof(double);
+    }
+
+    t.filas = cab.filas;
+    return true;
+}
+
+/*
+ * Abre la tabla de `ruta` (`-` es la entrada estándar) y decide su formato por la
+ * «firma» del principio. Si el archivo no se puede proyectar (e.g. es una tubería) lo
+ * leemos entero a memoria; en ese caso las tablas binarias sí se copian.
+ */
+bool abreTabla(std::string const& ruta, TablaColumnas& t) {
+    t.filas = 0;
+    t.archivo = abreArchivo(ruta);
+    if (t.archivo.fd < 0) {
+        t.error = "cannot open the file";
+        return false;
+    }
+
+    const char* texto = t.archivo.datos;
+    size_t tam = t.archivo.tam;
+    std::vector<char> copia;
+    if (texto == NULL) {
+        std::vector<char> bloque(1 << 20);
+        long n;
+        while ((n = leeBloque(t.archivo, bloque.data(), bloque.size())) > 0)
+            copia.insert(copia.end(), bloque.begin(), bloque.begin() + n);
+        if (n < 0) {
+            t.error = "read failed";
+            return false;
+        }
+        texto = copia.data();
+        tam = copia.size();
+    }
+
+    size_t firma = sizeof(COLUMNAS_FIRMA) - 1;
+    if (tam < firma || std::memcmp(texto, COLUMNAS_FIRMA, firma) != 0)
+        return leeTablaTexto(texto, tam, t);
+
+    if (!leeTablaBinaria(texto, tam, t))
+        return false;
+    if (texto == copia.data()) {
+        // Las columnas apuntan a `copia`, que desaparece al salir: las pasamos a `datos`.
+        for (uint64_t c = 0; c < t.columnas.size(); c++) {
+            t.datos.push_back(std::vector<double>(t.columnas[c], t.columnas[c] + t.filas));
+            t.columnas[c] = t.datos.back().data();
+        }
+    }
+    return true;
+}
+
+void cierraTabla(TablaColumnas& t) {
+    cierraArchivo(t.archivo);
+    t.columnas.clear();
+    t.datos.clear();
+    t.nombres.clear();
+    t.filas = 0;
+}
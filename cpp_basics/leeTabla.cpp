@@ -0,0 +1,96 @@
+/*
+ * Este programa es el complemento de `creaDatos.cpp` y `creaDatosRapido.cpp`: lee una
+ * tabla como `parabola.txt` (o `parabola.bin`, su versión binaria) con `lectorTabla.cpp`
+ * y trabaja directamente sobre sus columnas. Para cada una muestra la suma de sus
+ * valores y su integral respecto a la primera columna con la regla del trapecio:
+ * en `parabola.txt` la integral de `x^2` entre `1` y `9` es `728/3 = 242.67`, aunque
+ * con tan pocos puntos el trapecio da `244`.
+ *
+ * Uso: ./leeTabla.ex [archivo]
+ *  archivo: La tabla a leer. Por defecto `parabola.txt`; con `-` se lee la entrada estándar.
+ */
+
+/*
+ * Define `std::cout` para escribir a pantalla (i.e. `stdout`) y `std::cerr` para
+ * mostrar la velocidad de lectura por la salida de errores (i.e. `stderr`).
+ * Más información -> https://en.cppreference.com/w/cpp/header/iostream
+ */
+#include <iostream>
+
+/*
+ * Define `std::setprecision()` para mostrar las sumas con todas sus cifras.
+ * Más información -> https://en.cppreference.com/w/cpp/header/iomanip
+ */
+#include <iomanip>
+
+/*
+ * Define `std::string` para guardar la ruta del archivo.
+ * Más información -> https://en.cppreference.com/w/cpp/header/string
+ */
+#include <string>
+
+/*
+ * Define `std::chrono::steady_clock` para medir la lectura y los cálculos por separado.
+ * Más información -> https://en.cppreference.com/w/cpp/header/chrono
+ */
+#include <chrono>
+
+#include "lectorTabla.cpp"
+
+using namespace std;
+
+double sumaColumna(const double* y, uint64_t n) {
+    double suma = 0;
+    for (uint64_t i = 0; i < n; i++)
+        suma += y[i];
+    return suma;
+}
+
+// Integral de `y` respecto a `x` con la regla del trapecio; los puntos no tienen por qué estar equiespaciados.
+double trapecio(const double* x, const double* y, uint64_t n) {
+    double suma = 0;
+    for (uint64_t i = 1; i < n; i++)
+        suma += (x[i] - x[i - 1]) * (y[i] + y[i - 1]);
+    return suma / 2;
+}
+
+int main(int argc, char** argv) {
+    string ruta = "parabola.txt";
+
+    if (argc > 2 || (argc == 2 && argv[1][0] == '-' && argv[1][1] != '\0')) {
+        cout << "usage: " << argv[0] << " [archivo]\n";
+        return -1;
+    }
+    if (argc == 2)
+        ruta = argv[1];
+
+    TablaColumnas tabla;
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    bool ok = abreTabla(ruta, tabla);
+    chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+    if (!ok) {
+        cout << "error reading " << ruta << ": " << tabla.error << '\n';
+        cierraTabla(tabla);
+        return -1;
+    }
+
+    // Sin columnas no hay nada proyectado ni copiado: el archivo está vacío (o solo tiene líneas en blanco).
+    const char* origen = tabla.columnas.empty() ? " (tabla vacía)"
+                         : tabla.datos.empty()  ? " (proyectadas sin copiar)"
+                                                : " (leídas a memoria)";
+    cout << "Filas = " << tabla.filas << "; columnas = " << tabla.columnas.size() << origen << "\n";
+    for (size_t c = 0; c < tabla.columnas.size(); c++) {
+        cout << "\t" << tabla.nombres[c] << ": suma = " << setprecision(17) << sumaColumna(tabla.columnas[c], tabla.filas);
+        if (c > 0)
+            cout << "; integral = " << trapecio(tabla.columnas[0], tabla.columnas[c], tabla.filas);
+        cout << "\n";
+    }
+    chrono::steady_clock::time_point t2 = chrono::steady_clock::now();
+
+    double lectura = chrono::duration<double>(t1 - t0).count(), calculo = chrono::duration<double>(t2 - t1).count();
+    cerr << setprecision(3) << "Leídas " << tabla.filas << " filas en " << lectura << " s ("
+         << (lectura > 0 ? tabla.filas / lectura : 0) << " filas/s); cálculos en " << calculo << " s\n";
+
+    cierraTabla(tabla);
+    return 0;
+}
@@ -0,0 +1,115 @@
+/*
+ * Este programa calcula los mismos dos sumatorios que `optimiza.cpp`:
+ *      pi / 1 + pi / 2 + ... + pi / N
+ *      sqrt(pi) / 1 + sqrt(pi) / 2 + ... + sqrt(pi) / N
+ * pero apoyándose en el motor de `sumaArmonica.cpp`, que puede repartir el
+ * trabajo entre varios hilos y usar instrucciones vectoriales. Así podemos
+ * comparar los tiempos con los de `optimiza-0.ex` y `optimiza-2.ex`.
+ *
+ * Uso: ./optimiza-paralelo.ex [--threads N] [--simd] [--suma MODO]
+ *  --threads N: Número de hilos a emplear. Con `0` se usan todos los núcleos. Por defecto `1`.
+ *  --simd: Activa la versión vectorial (AVX2/AVX-512) del bucle.
+ *  --suma MODO: Modo de acumulación de `sumas.cpp`: `ingenua` (por defecto), `kahan`,
+ *               `neumaier` o `pareada`. Junto al resultado se muestra una cota del error.
+ */
+
+/*
+ * Define `std::cout` para escribir a pantalla (i.e. `stdout`).
+ * Más información -> https://en.cppreference.com/w/cpp/header/iostream
+ */
+#include <iostream>
+
+/*
+ * Define `double acos(double)` y `double sqrt(double)`.
+ * Más información -> https://en.cppreference.com/w/cpp/header/cmath
+ */
+#include <cmath>
+
+/*
+ * Define `std::string` y `std::stoi()` para leer los argumentos.
+ * Más información -> https://en.cppreference.com/w/cpp/header/string
+ */
+#include <string>
+
+/*
+ * Define `std::chrono::steady_clock` para medir el tiempo de cada bucle.
+ * Más información -> https://en.cppreference.com/w/cpp/header/chrono
+ */
+#include <chrono>
+
+/*
+ * Define `std::setprecision()` para mostrar todas las cifras de cada suma.
+ * Más información -> https://en.cppreference.com/w/cpp/header/iomanip
+ */
+#include <iomanip>
+
+#include "sumaArmonica.cpp"
+
+// El mismo número de iteraciones que en `optimiza.cpp`.
+#define N 2000000000
+
+using namespace std;
+
+int main(int argc, char** argv) {
+    unsigned hilos = 1;
+    bool simd = false;
+    ModoSuma modo = SUMA_INGENUA;
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--simd") {
+            simd = true;
+        } else if (arg == "--suma" && i + 1 < argc) {
+            if (!leeModoSuma(argv[++i], modo)) {
+                cout << "unknown summation mode: " << argv[i] << '\n';
+                return -1;
+            }
+        } else if (arg == "--threads" && i + 1 < argc) {
+            // Leemos con signo: `-1` guardado directamente en un `unsigned` sería 4294967295 hilos.
+            int leidos;
+            try {
+                leidos = stoi(argv[++i]);
+            } catch (invalid_argument const& ex) {
+                cout << "error parsing the number of threads: " << ex.what() << '\n';
+                return -1;
+            } catch (out_of_range const& ex) {
+                cout << "the number of threads is out of range: " << ex.what() << '\n';
+                return -1;
+            }
+            if (leidos < 0) {
+                cout << "the number of threads MUST be at least 0\n";
+                return -1;
+            }
+            hilos = leidos;
+        } else {
+            cout << "usage: " << argv[0] << " [--threads N] [--simd] [--suma ingenua|kahan|neumaier|pareada]\n";
+            return -1;
+        }
+    }
+
+    /*
+     * Calculamos `sqrt(pi)` una única vez fuera del bucle: en `optimiza.cpp`
+     * se reevalúa en cada iteración cuando compilamos con `-O0`.
+     */
+    double pi = acos(-1), raizPi = sqrt(pi);
+
+    cout << "Hilos: " << (hilos ? to_string(hilos) : "todos") << "; SIMD: "
+         << (simd ? sumaArmonicaSimdNombre() : "no") << "; suma: " << nombreModoSuma(modo) << "\n";
+
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    ResultadoSuma suma1 = sumaArmonica(pi, N, hilos, simd, modo);
+    chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+    ResultadoSuma suma2 = sumaArmonica(raizPi, N, hilos, simd, modo);
+    chrono::steady_clock::time_point t2 = chrono::steady_clock::now();
+
+    /*
+     * A diferencia de `optimiza.cpp` imprimimos los resultados: si no lo hiciéramos
+     * el compilador podría descartar los cálculos por no tener efecto alguno.
+     */
+    cout << "Suma de pi / i = " << setprecision(17) << suma1.suma << " +- " << setprecision(3) << suma1.cotaError
+         << " (" << chrono::duration<double>(t1 - t0).count() << " s)\n";
+    cout << "Suma de sqrt(pi) / i = " << setprecision(17) << suma2.suma << " +- " << setprecision(3) << suma2.cotaError
+         << " (" << chrono::duration<double>(t2 - t1).count() << " s)\n";
+
+    return 0;
+}
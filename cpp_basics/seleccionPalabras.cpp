@@ -134,9 +134,14 @@ int main() {
          * equivalencia) esta comprobación puede pasar a ser:
          *  !(n_palabras % select)
          * No obstante, la opción que hemos escogido es mucho más legible.
+         * Nótese que terminamos cada palabra con `"\n"` y no con `endl`: además de
+         * añadir el salto de línea, `endl` vacía el flujo, es decir, obliga a escribir
+         * en el archivo todo lo acumulado hasta el momento. Hacerlo tras cada palabra
+         * multiplica las escrituras y ralentiza muchísimo el programa. Podéis ver una
+         * versión que lleva esta idea más allá en `seleccionPalabrasRapido.cpp`.
          */
         if (n_palabras % select == 0)
-            fsalida << palabra << endl;
+            fsalida << palabra << "\n";
 
         // Mientras quede archivo por leer seguimos extrayendo palabras...
         mif >> palabra;
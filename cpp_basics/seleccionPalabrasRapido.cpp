@@ -0,0 +1,247 @@
+/*
+ * Este programa generaliza `seleccionPalabras.cpp`: lee las palabras de un archivo,
+ * se queda con las que cumplen una serie de criterios y las escribe, una por línea,
+ * a otro archivo. Las diferencias principales son:
+ *  - La entrada se proyecta en memoria (ver `archivoMapeado.cpp`) y las palabras se
+ *    recorren «en el sitio», sin copiarlas a `std::string`s.
+ *  - La salida se acumula en un buffer grande (ver `escritorBuffer.cpp`) en vez de
+ *    vaciar el flujo con `endl` tras cada palabra.
+ *  - Los criterios de selección se eligen desde la línea de comandos y se pueden
+ *    combinar: una palabra se escribe si los cumple **todos**.
+ *
+ * Uso: ./seleccionPalabrasRapido.ex [criterios...] [-o salida] [entrada]
+ *  --cada K: Palabras en posiciones múltiplo de `K` (la 1ª palabra es la posición 1).
+ *  --longitud MIN[:MAX]: Palabras con entre `MIN` y `MAX` caracteres (UTF-8).
+ *  --regex EXPR: Palabras que contienen una coincidencia con la expresión regular `EXPR`.
+ *  --rango INI:FIN: Palabras en las posiciones `[INI, FIN]`.
+ *  -o salida: Archivo de salida. Por defecto `parte_libro.txt`; con `-` se escribe a `stdout`.
+ *  entrada: Archivo de entrada. Por defecto `libro.txt`; con `-` se lee la entrada estándar.
+ * Si no se indica ningún criterio se usa `--cada 2`, como en `seleccionPalabras.cpp`.
+ */
+
+/*
+ * Define `std::cout` para escribir a pantalla (i.e. `stdout`) y `std::cerr` para
+ * mostrar las estadísticas por la salida de errores (i.e. `stderr`).
+ * Más información -> https://en.cppreference.com/w/cpp/header/iostream
+ */
+#include <iostream>
+
+/*
+ * Define `std::string` y `std::stol()` para leer los argumentos.
+ * Más información -> https://en.cppreference.com/w/cpp/header/string
+ */
+#include <string>
+
+/*
+ * Define `std::vector`, donde guardamos los criterios y el buffer de lectura.
+ * Más información -> https://en.cppreference.com/w/cpp/header/vector
+ */
+#include <vector>
+
+/*
+ * Define `std::chrono::steady_clock` para calcular los MB/s escritos.
+ * Más información -> https://en.cppreference.com/w/cpp/header/chrono
+ */
+#include <chrono>
+
+/*
+ * Define `std::function`, que nos permite guardar criterios de distinto tipo
+ * (lambdas que capturan distintas variables) en un mismo `std::vector`.
+ * Más información -> https://en.cppreference.com/w/cpp/header/functional
+ */
+#include <functional>
+
+/*
+ * Define `std::regex` para trabajar con expresiones regulares.
+ * Más información -> https://en.cppreference.com/w/cpp/header/regex
+ */
+#include <regex>
+
+// También incluye `archivoMapeado.cpp`.
+#include "contadorPalabras.cpp"
+#include "escritorBuffer.cpp"
+
+using namespace std;
+
+// Una palabra de la entrada: una vista al texto y su posición (empezando en 1).
+struct Palabra {
+    const char* texto;
+    size_t len;
+    long posicion;
+};
+
+typedef function<bool(Palabra const&)> Criterio;
+
+/*
+ * Llama a `alEncontrar(texto, len)` para cada palabra del archivo. Si el archivo está
+ * proyectado recorremos directamente la memoria. Si no, lo leemos por bloques y, si
+ * una palabra queda partida entre dos bloques, movemos su comienzo al principio del
+ * buffer antes de leer el siguiente.
+ */
+template <typename F>
+bool recorrePalabras(ArchivoMapeado const& a, F alEncontrar) {
+    if (a.datos != NULL) {
+        const char *p = a.datos, *fin = a.datos + a.tam;
+        while (p < fin) {
+            while (p < fin && esEspacio(*p))
+                p++;
+            const char* ini = p;
+            while (p < fin && !esEspacio(*p))
+                p++;
+            if (p > ini)
+                alEncontrar(ini, p - ini);
+        }
+        return true;
+    }
+
+    vector<char> buffer(BLOQUE_LECTURA);
+    size_t pendiente = 0;
+
+    while (true) {
+        // Si una única palabra ocupa todo el buffer lo agrandamos.
+        if (pendiente == buffer.size())
+            buffer.resize(2 * buffer.size());
+
+        long n = leeBloque(a, buffer.data() + pendiente, buffer.size() - pendiente);
+        if (n < 0)
+            return false;
+
+        const char *p = buffer.data(), *fin = buffer.data() + pendiente + n;
+        size_t resto = 0;
+        while (p < fin) {
+            while (p < fin && esEspacio(*p))
+                p++;
+            const char* ini = p;
+            while (p < fin && !esEspacio(*p))
+                p++;
+            if (p == ini)
+                break;
+            // La última palabra del bloque puede continuar en el siguiente, salvo que ya no quede nada por leer.
+            if (p == fin && n > 0) {
+                resto = fin - ini;
+                memmove(buffer.data(), ini, resto);
+                break;
+            }
+            alEncontrar(ini, p - ini);
+        }
+        pendiente = resto;
+
+        if (n == 0)
+            return true;
+    }
+}
+
+// Lee `"A:B"` o `"A"` (en cuyo caso `b` no se modifica).
+void leeIntervalo(string const& s, long& a, long& b) {
+    size_t dosPuntos = s.find(':');
+    a = stol(s.substr(0, dosPuntos));
+    if (dosPuntos != string::npos)
+        b = stol(s.substr(dosPuntos + 1));
+}
+
+// Número de caracteres UTF-8 de una palabra: todos los bytes que no son de continuación.
+size_t caracteres(const char* p, size_t len) {
+    size_t n = 0;
+    for (size_t i = 0; i < len; i++)
+        n += (p[i] & 0xC0) != 0x80;
+    return n;
+}
+
+int main(int argc, char** argv) {
+    string entrada = "libro.txt", salida = "parte_libro.txt";
+    vector<Criterio> criterios;
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        try {
+            if (arg == "--cada" && i + 1 < argc) {
+                long k = stol(argv[++i]);
+                if (k <= 0)
+                    throw invalid_argument("--cada must be positive");
+                criterios.push_back([k](Palabra const& p) { return p.posicion % k == 0; });
+            } else if (arg == "--longitud" && i + 1 < argc) {
+                long minimo, maximo = -1;
+                leeIntervalo(argv[++i], minimo, maximo);
+                criterios.push_back([minimo, maximo](Palabra const& p) {
+                    long n = caracteres(p.texto, p.len);
+                    return n >= minimo && (maximo < 0 || n <= maximo);
+                });
+            } else if (arg == "--regex" && i + 1 < argc) {
+                regex expresion(argv[++i]);
+                criterios.push_back([expresion](Palabra const& p) {
+                    return regex_search(p.texto, p.texto + p.len, expresion);
+                });
+            } else if (arg == "--rango" && i + 1 < argc) {
+                long ini, fin = -1;
+                leeIntervalo(argv[++i], ini, fin);
+                criterios.push_back([ini, fin](Palabra const& p) {
+                    return p.posicion >= ini && (fin < 0 || p.posicion <= fin);
+                });
+            } else if (arg == "-o" && i + 1 < argc) {
+                salida = argv[++i];
+            } else if (arg.size() > 1 && arg[0] == '-') {
+                cout << "usage: " << argv[0] << " [--cada K] [--longitud MIN[:MAX]] [--regex EXPR] "
+                     << "[--rango INI:FIN] [-o salida] [entrada]\n";
+                return -1;
+            } else {
+                entrada = arg;
+            }
+        } catch (invalid_argument const& ex) {
+            cout << "error parsing the input arguments: " << ex.what() << '\n';
+            return -1;
+        } catch (out_of_range const& ex) {
+            cout << "the input arguments are out of range: " << ex.what() << '\n';
+            return -1;
+        } catch (regex_error const& ex) {
+            cout << "error parsing the regular expression: " << ex.what() << '\n';
+            return -1;
+        }
+    }
+
+    if (criterios.empty())
+        criterios.push_back([](Palabra const& p) { return p.posicion % 2 == 0; });
+
+    ArchivoMapeado archivo = abreArchivo(entrada);
+    if (archivo.fd < 0) {
+        cout << "error opening " << entrada << '\n';
+        return -1;
+    }
+
+    int fd = salida == "-" ? STDOUT_FILENO : open(salida.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        cout << "error opening " << salida << '\n';
+        return -1;
+    }
+
+    EscritorBuffer escritor = creaEscritor(fd);
+    long posicion = 0, seleccionadas = 0;
+
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    bool ok = recorrePalabras(archivo, [&](const char* texto, size_t len) {
+        Palabra p = {texto, len, ++posicion};
+        for (Criterio const& c : criterios)
+            if (!c(p))
+                return;
+        // Tras un error el escritor ya no escribe nada; `vuelcaEscritor()` lo avisará al final.
+        if (escribe(escritor, texto, len) && escribe(escritor, '\n'))
+            seleccionadas++;
+    });
+    ok = vuelcaEscritor(escritor) && ok;
+    chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+
+    cierraArchivo(archivo);
+    if (fd != STDOUT_FILENO)
+        close(fd);
+
+    if (!ok) {
+        cout << "error reading " << entrada << " or writing " << salida << '\n';
+        return -1;
+    }
+
+    double segundos = chrono::duration<double>(t1 - t0).count();
+    cerr << "Seleccionadas " << seleccionadas << " de " << posicion << " palabras: "
+         << escritor.bytesEscritos << " bytes en " << escritor.llamadas << " llamadas a write() ("
+         << (segundos > 0 ? escritor.bytesEscritos / segundos / 1e6 : 0) << " MB/s)\n";
+
+    return 0;
+}
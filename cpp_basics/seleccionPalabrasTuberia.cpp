@@ -0,0 +1,87 @@
+/*
+ * Este programa selecciona una de cada `K` palabras de un archivo y las escribe a
+ * otro, igual que `seleccionPalabras.cpp`, pero es una simple configuración de la
+ * tubería de `tuberiaTexto.cpp`. Al terminar muestra las estadísticas de cada etapa
+ * y cola por `stderr`.
+ *
+ * Uso: ./seleccionPalabrasTuberia.ex [--cada K] [-o salida] [entrada]
+ *  --cada K: Selecciona las palabras en posiciones múltiplo de `K`. Por defecto `2`.
+ *  -o salida: Archivo de salida. Por defecto `parte_libro.txt`; con `-` se escribe a `stdout`.
+ *  entrada: Archivo de entrada. Por defecto `libro.txt`; con `-` se lee la entrada estándar.
+ */
+
+/*
+ * Define `std::cout` para escribir a pantalla (i.e. `stdout`) y `std::cerr` para
+ * mostrar las estadísticas de la tubería por la salida de errores (i.e. `stderr`).
+ * Más información -> https://en.cppreference.com/w/cpp/header/iostream
+ */
+#include <iostream>
+
+/*
+ * Define `std::string` y `std::stol()` para leer los argumentos.
+ * Más información -> https://en.cppreference.com/w/cpp/header/string
+ */
+#include <string>
+
+#include "tuberiaTexto.cpp"
+
+using namespace std;
+
+int main(int argc, char** argv) {
+    string entrada = "libro.txt", salida = "parte_libro.txt";
+    long select = 2;
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--cada" && i + 1 < argc) {
+            try {
+                select = stol(argv[++i]);
+                if (select <= 0)
+                    throw invalid_argument("--cada must be positive");
+            } catch (invalid_argument const& ex) {
+                cout << "error parsing the input arguments: " << ex.what() << '\n';
+                return -1;
+            } catch (out_of_range const& ex) {
+                cout << "the argument of --cada is out of range: " << ex.what() << '\n';
+                return -1;
+            }
+        } else if (arg == "-o" && i + 1 < argc) {
+            salida = argv[++i];
+        } else if (arg.size() > 1 && arg[0] == '-') {
+            cout << "usage: " << argv[0] << " [--cada K] [-o salida] [entrada]\n";
+            return -1;
+        } else {
+            entrada = arg;
+        }
+    }
+
+    int fdEntrada = entrada == "-" ? STDIN_FILENO : open(entrada.c_str(), O_RDONLY);
+    if (fdEntrada < 0) {
+        cout << "error opening " << entrada << '\n';
+        return -1;
+    }
+
+    int fdSalida = salida == "-" ? STDOUT_FILENO : open(salida.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fdSalida < 0) {
+        cout << "error opening " << salida << '\n';
+        return -1;
+    }
+
+    EstadisticasTuberia est = ejecutaTuberia(configTuberia(fdEntrada, fdSalida), [select](const char*, size_t, long posicion) {
+        return posicion % select == 0;
+    });
+
+    if (fdEntrada != STDIN_FILENO)
+        close(fdEntrada);
+    if (fdSalida != STDOUT_FILENO)
+        close(fdSalida);
+
+    if (est.error) {
+        cout << "error reading " << entrada << " or writing " << salida << '\n';
+        return -1;
+    }
+
+    muestraEstadisticas(cerr, est);
+
+    return 0;
+}
@@ -0,0 +1,179 @@
+/*
+ * Este archivo no contiene un `main()`: recoge el «motor» que calcula
+ * sumas armónicas del estilo de las de `optimiza.cpp`, es decir,
+ *      x / 1 + x / 2 + ... + x / n
+ * para que otros programas lo puedan incluir con `#include "sumaArmonica.cpp"`,
+ * tal y como se hace en los ejemplos de `funcs_n_ptrs`.
+ *
+ * La idea es mostrar dos técnicas que van más allá de los niveles de
+ * optimización del compilador (i.e. `-O0` y `-O2`):
+ *  - Vectorización (SIMD): procesamos varios términos de golpe con las
+ *    instrucciones AVX2 (4 `double`s) o AVX-512 (8 `double`s) del procesador.
+ *  - Paralelismo: repartimos el rango `[1, n]` entre varios hilos, cada uno con
+ *    su propia suma parcial, y sumamos los parciales al final.
+ */
+
+/*
+ * Define `std::thread`, que nos permite lanzar funciones en hilos de ejecución
+ * independientes. Para compilar hay que pasar `-pthread` a `g++`.
+ * Más información -> https://en.cppreference.com/w/cpp/header/thread
+ */
+#include <thread>
+
+/*
+ * Define `std::vector`, un «array» que puede crecer dinámicamente. Lo usamos
+ * para guardar los hilos y las sumas parciales de cada uno.
+ * Más información -> https://en.cppreference.com/w/cpp/header/vector
+ */
+#include <vector>
+
+/*
+ * Define los distintos modos de acumulación (Kahan, pareada...) y el tipo
+ * `ResultadoSuma`, que acompaña cada suma con una cota de su error.
+ */
+#include "sumas.cpp"
+
+/*
+ * Las instrucciones vectoriales se usan a través de los llamados «intrínsecos»:
+ * funciones como `_mm512_div_pd()` que el compilador traduce a una única
+ * instrucción. Solo están disponibles si compilamos para un procesador que las
+ * soporte (e.g. con `-march=native`), de ahí que el compilador defina las macros
+ * `__AVX512F__` o `__AVX2__`. Si no están definidas recurrimos a la versión escalar.
+ * Más información -> https://www.intel.com/content/www/us/en/docs/intrinsics-guide/index.html
+ */
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+/*
+ * Devuelve el nombre del juego de instrucciones vectoriales con el que se ha
+ * compilado el motor para que los programas lo puedan mostrar.
+ */
+const char* sumaArmonicaSimdNombre() {
+#if defined(__AVX512F__)
+    return "AVX-512";
+#elif defined(__AVX2__)
+    return "AVX2";
+#else
+    return "ninguno (escalar)";
+#endif
+}
+
+/*
+ * Versión escalar: suma `x / i` para `i` en `[ini, fin]`. Es el mismo bucle que
+ * el de `optimiza.cpp`, pero con un `long` como variable de control para poder
+ * trabajar con rangos que no quepan en un `int`.
+ */
+double sumaArmonicaEscalar(double x, long ini, long fin) {
+    double suma = 0;
+    for (long i = ini; i <= fin; i++)
+        suma += x / double(i);
+    return suma;
+}
+
+/*
+ * Versión vectorial: en vez de llevar la cuenta de `i` como un entero mantenemos
+ * un vector de `double`s con varios índices consecutivos (e.g. `{1, 2, 3, 4}`)
+ * que incrementamos en bloque. Usamos dos acumuladores independientes para que
+ * una suma no tenga que esperar a que termine la anterior. Los términos que no
+ * completan un bloque se suman con la versión escalar.
+ */
+double sumaArmonicaSimd(double x, long ini, long fin) {
+#if defined(__AVX512F__)
+    const long L = 8;
+    __m512d vx = _mm512_set1_pd(x), paso = _mm512_set1_pd(2 * L);
+    __m512d i0 = _mm512_add_pd(_mm512_set1_pd(ini), _mm512_setr_pd(0, 1, 2, 3, 4, 5, 6, 7));
+    __m512d i1 = _mm512_add_pd(i0, _mm512_set1_pd(L));
+    __m512d acc0 = _mm512_setzero_pd(), acc1 = _mm512_setzero_pd();
+
+    long i = ini;
+    for (; fin - i + 1 >= 2 * L; i += 2 * L) {
+        acc0 = _mm512_add_pd(acc0, _mm512_div_pd(vx, i0));
+        acc1 = _mm512_add_pd(acc1, _mm512_div_pd(vx, i1));
+        i0 = _mm512_add_pd(i0, paso);
+        i1 = _mm512_add_pd(i1, paso);
+    }
+
+    /*
+     * Volcamos el acumulador a un array en vez de usar `_mm512_reduce_add_pd()`:
+     * con GCC 12 ese intrínseco genera un aviso espurio con `-Wextra`.
+     */
+    double parcial[L], suma = 0;
+    _mm512_storeu_pd(parcial, _mm512_add_pd(acc0, acc1));
+    for (long k = 0; k < L; k++)
+        suma += parcial[k];
+
+    return suma + sumaArmonicaEscalar(x, i, fin);
+#elif defined(__AVX2__)
+    const long L = 4;
+    __m256d vx = _mm256_set1_pd(x), paso = _mm256_set1_pd(2 * L);
+    __m256d i0 = _mm256_add_pd(_mm256_set1_pd(ini), _mm256_setr_pd(0, 1, 2, 3));
+    __m256d i1 = _mm256_add_pd(i0, _mm256_set1_pd(L));
+    __m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd();
+
+    long i = ini;
+    for (; fin - i + 1 >= 2 * L; i += 2 * L) {
+        acc0 = _mm256_add_pd(acc0, _mm256_div_pd(vx, i0));
+        acc1 = _mm256_add_pd(acc1, _mm256_div_pd(vx, i1));
+        i0 = _mm256_add_pd(i0, paso);
+        i1 = _mm256_add_pd(i1, paso);
+    }
+
+    // AVX2 no tiene una reducción horizontal directa: volcamos el vector a un array.
+    double parcial[L];
+    _mm256_storeu_pd(parcial, _mm256_add_pd(acc0, acc1));
+
+    return parcial[0] + parcial[1] + parcial[2] + parcial[3] + sumaArmonicaEscalar(x, i, fin);
+#else
+    return sumaArmonicaEscalar(x, ini, fin);
+#endif
+}
+
+/*
+ * Calcula `x / 1 + ... + x / n` repartiendo el rango entre `hilos` hilos. Si
+ * `hilos` es `0` usamos tantos como núcleos tenga la máquina. Cada hilo escribe
+ * su resultado en su propia posición de `parciales`, con lo que no hace falta
+ * sincronización alguna más allá de esperar a que todos terminen con `join()`.
+ * Cada hilo acumula su tramo con el `modo` indicado (ver `sumas.cpp`); la versión
+ * vectorial solo se emplea con el modo ingenuo, ya que el resto dependen del
+ * orden en el que se suman los términos.
+ */
+ResultadoSuma sumaArmonica(double x, long n, unsigned hilos, bool simd, ModoSuma modo = SUMA_INGENUA) {
+    if (hilos == 0)
+        hilos = std::thread::hardware_concurrency();
+    if (hilos == 0)
+        hilos = 1;
+    if (n < long(hilos))
+        hilos = n > 0 ? n : 1;
+
+    std::vector<ResultadoSuma> parciales(hilos);
+    std::vector<std::thread> trabajadores;
+    long tramo = n / hilos;
+
+    for (unsigned h = 0; h < hilos; h++) {
+        long ini = 1 + h * tramo, fin = (h == hilos - 1) ? n : ini + tramo - 1;
+        trabajadores.push_back(std::thread([=, &parciales]() {
+            if (simd && modo == SUMA_INGENUA) {
+                /*
+                 * Todos los términos tienen el mismo signo, con lo que la suma de sus
+                 * valores absolutos es el valor absoluto de la suma. Cada carril
+                 * vectorial acumula, como mucho, `fin - ini + 1` términos.
+                 */
+                double s = sumaArmonicaSimd(x, ini, fin);
+                ResultadoSuma r = {s, gammaSuma(fin - ini) * std::fabs(s)};
+                parciales[h] = r;
+            } else {
+                parciales[h] = sumaConModo([x](long i) { return x / double(i); }, ini, fin, modo);
+            }
+        }));
+    }
+
+    // Sumamos los parciales siempre en el mismo orden para que el resultado sea reproducible.
+    ResultadoSuma total = {0, 0};
+    for (unsigned h = 0; h < hilos; h++) {
+        trabajadores[h].join();
+        total = combinaSumas(total, parciales[h]);
+    }
+
+    return total;
+}
@@ -0,0 +1,254 @@
+/*
+ * Este archivo no contiene un `main()`: recoge varias formas de acumular un
+ * sumatorio para que otros programas (e.g. `sumatorio.cpp` y `sumaArmonica.cpp`)
+ * las puedan incluir con `#include "sumas.cpp"`.
+ *
+ * Un bucle como `suma += x / i` tiene dos problemas cuando el número de términos
+ * es enorme:
+ *  - Cada suma redondea el resultado, con lo que el error crece con el número de
+ *    términos. Para `N = 2000000000` podemos perder varias cifras significativas.
+ *  - Cada suma depende de la anterior: el procesador no puede empezar la siguiente
+ *    hasta que acabe la actual, aunque sea capaz de hacer varias a la vez.
+ *
+ * Los modos que ofrecemos son:
+ *  - Ingenua: el bucle de toda la vida.
+ *  - Kahan: arrastra el error de cada suma en una variable de «compensación».
+ *    Más información -> https://en.wikipedia.org/wiki/Kahan_summation_algorithm
+ *  - Neumaier: variante de Kahan que también funciona si un término es mayor que
+ *    la suma acumulada hasta el momento.
+ *  - Pareada: suma los términos en bloques con varios acumuladores independientes
+ *    y luego combina los bloques por parejas, como en un árbol. El error crece con
+ *    el logaritmo del número de términos y las sumas de cada bloque se solapan.
+ *    Más información -> https://en.wikipedia.org/wiki/Pairwise_summation
+ *
+ * Junto a la suma devolvemos una cota superior del error cometido según los
+ * análisis de N. J. Higham, «Accuracy and Stability of Numerical Algorithms», cap. 4.
+ */
+
+/*
+ * Define `std::fabs()`.
+ * Más información -> https://en.cppreference.com/w/cpp/header/cmath
+ */
+#include <cmath>
+
+/*
+ * Define `DBL_EPSILON`, la distancia entre `1.0` y el siguiente `double`.
+ * Más información -> https://en.cppreference.com/w/cpp/header/cfloat
+ */
+#include <cfloat>
+
+/*
+ * Define `std::string` para poder leer el modo desde la línea de comandos.
+ * Más información -> https://en.cppreference.com/w/cpp/header/string
+ */
+#include <string>
+
+// Los términos de cada bloque del modo pareado y el número de acumuladores por bloque.
+#define SUMA_BLOQUE 256
+#define SUMA_ACUMULADORES 4
+
+enum ModoSuma { SUMA_INGENUA, SUMA_KAHAN, SUMA_NEUMAIER, SUMA_PAREADA };
+
+/*
+ * El resultado de un sumatorio: el valor calculado y una cota del error absoluto
+ * cometido, es decir, |suma - valor exacto| <= cotaError.
+ */
+struct ResultadoSuma {
+    double suma;
+    double cotaError;
+};
+
+const char* nombreModoSuma(ModoSuma modo) {
+    switch (modo) {
+        case SUMA_INGENUA:
+            return "ingenua";
+        case SUMA_KAHAN:
+            return "kahan";
+        case SUMA_NEUMAIER:
+            return "neumaier";
+        case SUMA_PAREADA:
+            return "pareada";
+        default:
+            return "desconocido";
+    }
+}
+
+// Traduce un nombre (e.g. `"kahan"`) a su modo. Devuelve `false` si no lo reconoce.
+bool leeModoSuma(const std::string& nombre, ModoSuma& modo) {
+    const ModoSuma modos[] = {SUMA_INGENUA, SUMA_KAHAN, SUMA_NEUMAIER, SUMA_PAREADA};
+    for (int i = 0; i < 4; i++) {
+        if (nombre == nombreModoSuma(modos[i])) {
+            modo = modos[i];
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * Cota de Higham: gamma(k) = k * u / (1 - k * u), donde `u` es el error de
+ * redondeo unitario (la mitad de `DBL_EPSILON`).
+ */
+double gammaSuma(double k) {
+    double ku = k * DBL_EPSILON / 2;
+    return ku / (1 - ku);
+}
+
+// Número de niveles de un árbol binario con `n` hojas, i.e. ceil(log2(n)).
+int nivelesSuma(long n) {
+    int niveles = 0;
+    for (long hojas = 1; hojas < n; hojas *= 2)
+        niveles++;
+    return niveles;
+}
+
+/*
+ * Combina dos sumatorios parciales, e.g. los calculados por dos hilos. La suma
+ * final introduce un redondeo más, a lo sumo de `u * |suma|`.
+ */
+ResultadoSuma combinaSumas(ResultadoSuma a, ResultadoSuma b) {
+    ResultadoSuma r;
+    r.suma = a.suma + b.suma;
+    r.cotaError = a.cotaError + b.cotaError + DBL_EPSILON / 2 * std::fabs(r.suma);
+    return r;
+}
+
+/*
+ * Las funciones siguientes suman `termino(i)` para `i` en `[ini, fin]`. Usamos
+ * una plantilla (i.e. `template`) para que `termino` pueda ser cualquier cosa que
+ * se pueda «llamar» con un `long`: una función, una lambda... Al conocer su tipo en
+ * tiempo de compilación el compilador puede insertar su código dentro del bucle.
+ * Más información -> https://en.cppreference.com/w/cpp/language/templates
+ */
+template <typename F>
+ResultadoSuma sumaIngenua(F termino, long ini, long fin) {
+    double suma = 0, sumaAbs = 0;
+    for (long i = ini; i <= fin; i++) {
+        double t = termino(i);
+        suma += t;
+        sumaAbs += std::fabs(t);
+    }
+
+    ResultadoSuma r = {suma, gammaSuma(fin - ini) * sumaAbs};
+    return r;
+}
+
+template <typename F>
+ResultadoSuma sumaKahan(F termino, long ini, long fin) {
+    double suma = 0, c = 0, sumaAbs = 0;
+    for (long i = ini; i <= fin; i++) {
+        double t = termino(i);
+        // `c` guarda lo que se «perdió» en la suma anterior: lo restamos antes de sumar.
+        double y = t - c;
+        double s = suma + y;
+        c = (s - suma) - y;
+        suma = s;
+        sumaAbs += std::fabs(t);
+    }
+
+    double n = fin - ini + 1, u = DBL_EPSILON / 2;
+    ResultadoSuma r = {suma, (2 * u + n * u * u) * sumaAbs};
+    return r;
+}
+
+template <typename F>
+ResultadoSuma sumaNeumaier(F termino, long ini, long fin) {
+    double suma = 0, c = 0, sumaAbs = 0;
+    for (long i = ini; i <= fin; i++) {
+        double t = termino(i);
+        double s = suma + t;
+        // Recuperamos la parte del sumando pequeño que se ha perdido al redondear.
+        if (std::fabs(suma) >= std::fabs(t))
+            c += (suma - s) + t;
+        else
+            c += (t - s) + suma;
+        suma = s;
+        sumaAbs += std::fabs(t);
+    }
+
+    double n = fin - ini + 1, u = DBL_EPSILON / 2;
+    ResultadoSuma r = {suma + c, (2 * u + n * u * u) * sumaAbs};
+    return r;
+}
+
+template <typename F>
+ResultadoSuma sumaPareada(F termino, long ini, long fin) {
+    /*
+     * En vez de guardar todos los bloques y sumarlos al final llevamos una «pila»
+     * con un parcial por nivel del árbol, como si contáramos en binario: cuando dos
+     * parciales ocupan el mismo nivel los sumamos y subimos el resultado de nivel.
+     * Con 64 niveles podemos sumar cualquier rango que quepa en un `long`.
+     */
+    double pila[64], sumaAbs = 0;
+    int nivel[64], cima = 0;
+    long nBloques = 0;
+
+    for (long bloque = ini; bloque <= fin; bloque += SUMA_BLOQUE) {
+        long ultimo = fin - bloque < SUMA_BLOQUE ? fin : bloque + SUMA_BLOQUE - 1;
+
+        // Los acumuladores independientes permiten que varias sumas estén «en vuelo» a la vez.
+        double acc[SUMA_ACUMULADORES] = {0}, accAbs[SUMA_ACUMULADORES] = {0};
+        long i = bloque;
+        for (; i + SUMA_ACUMULADORES - 1 <= ultimo; i += SUMA_ACUMULADORES) {
+            for (int k = 0; k < SUMA_ACUMULADORES; k++) {
+                double t = termino(i + k);
+                acc[k] += t;
+                accAbs[k] += std::fabs(t);
+            }
+        }
+        for (; i <= ultimo; i++) {
+            double t = termino(i);
+            acc[0] += t;
+            accAbs[0] += std::fabs(t);
+        }
+
+        double parcial = 0;
+        for (int k = 0; k < SUMA_ACUMULADORES; k++) {
+            parcial += acc[k];
+            sumaAbs += accAbs[k];
+        }
+
+        int nivelParcial = 0;
+        while (cima > 0 && nivel[cima - 1] == nivelParcial) {
+            parcial += pila[--cima];
+            nivelParcial++;
+        }
+        pila[cima] = parcial;
+        nivel[cima++] = nivelParcial;
+        nBloques++;
+    }
+
+    // Los niveles que han quedado sin pareja se suman del más bajo al más alto.
+    double suma = 0;
+    while (cima > 0)
+        suma += pila[--cima];
+
+    /*
+     * La cota es `gamma(k) * sum |x_i|`, con `k` el máximo de sumas que atraviesa un
+     * término. Dentro de su bloque (la «hoja» del árbol) encadena las de su acumulador,
+     * `porBloque / SUMA_ACUMULADORES` más las `SUMA_ACUMULADORES - 1` sobrantes que van a
+     * `acc[0]`, y las `SUMA_ACUMULADORES` de combinar los acumuladores. Por encima suma
+     * una por nivel del árbol y, al final, una por cada parcial que se quedó sin pareja.
+     */
+    long porBloque = fin - ini + 1 < SUMA_BLOQUE ? fin - ini + 1 : SUMA_BLOQUE;
+    double hoja = porBloque / SUMA_ACUMULADORES + 2 * SUMA_ACUMULADORES - 1;
+    double arbol = 2 * nivelesSuma(nBloques) + 1;
+    ResultadoSuma r = {suma, gammaSuma(hoja + arbol) * sumaAbs};
+    return r;
+}
+
+// Punto de entrada común: suma `termino(i)` para `i` en `[ini, fin]` con el modo indicado.
+template <typename F>
+ResultadoSuma sumaConModo(F termino, long ini, long fin, ModoSuma modo) {
+    switch (modo) {
+        case SUMA_KAHAN:
+            return sumaKahan(termino, ini, fin);
+        case SUMA_NEUMAIER:
+            return sumaNeumaier(termino, ini, fin);
+        case SUMA_PAREADA:
+            return sumaPareada(termino, ini, fin);
+        case SUMA_INGENUA:
+        default:
+            return sumaIngenua(termino, ini, fin);
+    }
+}
@@ -4,6 +4,13 @@
  */
 #include <iostream>
 
+/*
+ * Incluimos directamente el código de `sumas.cpp`, que define varias formas de
+ * acumular un sumatorio (Kahan, pareada...) además de la «ingenua» que usamos en
+ * todos los bucles de este ejemplo. Las emplearemos al final del programa.
+ */
+#include "sumas.cpp"
+
 /*
  * Dado que vamos a iterar siempre 10 veces en cada uno de los bucles
  * vamos a definir una constante para controlar las iteraciones de
@@ -175,6 +182,22 @@ int main() {
     // Una vez calculado imprimimos el resultado por pantalla.
     cout << "Sumatorio = " << suma << "\n";
 
+    /*
+     * Por último calculamos el mismo sumatorio con cada uno de los modos de
+     * `sumas.cpp`. En vez de escribir el bucle nosotros le pasamos a `sumaConModo()`
+     * una lambda (i.e. una función sin nombre) que calcula el término `i`-ésimo.
+     * La sintaxis `[x]` indica que la lambda «captura» una copia de `x` para poder
+     * usarla. Con `N = 10` todos los modos dan el mismo resultado, pero la cota de
+     * error que acompaña a cada uno nos da una idea de cómo se comportarían con
+     * muchísimos más términos. Podéis encontrar más información sobre las lambdas en
+     * https://en.cppreference.com/w/cpp/language/lambda.
+     */
+    ModoSuma modos[] = {SUMA_INGENUA, SUMA_KAHAN, SUMA_NEUMAIER, SUMA_PAREADA};
+    for (ModoSuma modo : modos) {
+        ResultadoSuma r = sumaConModo([x](long i) { return x / double(i); }, 1, N, modo);
+        cout << "Sumatorio (" << nombreModoSuma(modo) << ") = " << r.suma << " +- " << r.cotaError << "\n";
+    }
+
     /*
      * A pesar de que no es «estrictamente» necesario, es una buena
      * costumbre devolver `0` para indicar a quien ha ejecutado el
@@ -0,0 +1,336 @@
+/*
+ * Este archivo no contiene un `main()`: cuenta cuántas veces aparece cada palabra
+ * de un texto en memoria (e.g. proyectado con `archivoMapeado.cpp`). Tiene tres
+ * partes bien diferenciadas:
+ *
+ *  - Decodificación UTF-8: los textos en castellano contienen caracteres como `á`,
+ *    `ñ` o `¿` que ocupan varios bytes. Los decodificamos para saber si forman parte
+ *    de una palabra y para pasarlos a minúsculas (i.e. `Árbol` y `árbol` son la
+ *    misma palabra). Los signos como `¿`, `¡`, `«` o `—` separan palabras.
+ *    Más información -> https://en.wikipedia.org/wiki/UTF-8
+ *
+ *  - Una tabla hash de «direccionamiento abierto»: todas las entradas viven en un
+ *    único array y, si la posición que le toca a una palabra está ocupada, probamos
+ *    con la siguiente. Esto es mucho más amable con la caché que las listas enlazadas
+ *    de `std::unordered_map`. Las claves son «vistas» (puntero y longitud) al texto
+ *    original, con lo que no reservamos memoria por palabra.
+ *    Más información -> https://en.wikipedia.org/wiki/Open_addressing
+ *
+ *  - Conteo en paralelo: cada hilo cuenta su trozo del texto en su propia tabla y al
+ *    final las combinamos, con lo que los hilos nunca compiten por la misma memoria.
+ */
+
+/*
+ * Define `uint32_t` y `uint64_t`, enteros con un tamaño garantizado.
+ * Más información -> https://en.cppreference.com/w/cpp/header/cstdint
+ */
+#include <cstdint>
+
+/*
+ * Define `std::string`, que usamos para devolver las palabras en minúsculas.
+ * Más información -> https://en.cppreference.com/w/cpp/header/string
+ */
+#include <string>
+
+/*
+ * Define `std::vector`, donde viven las entradas de cada tabla hash.
+ * Más información -> https://en.cppreference.com/w/cpp/header/vector
+ */
+#include <vector>
+
+/*
+ * Define `std::thread` para contar cada trozo del texto en un hilo distinto.
+ * Más información -> https://en.cppreference.com/w/cpp/header/thread
+ */
+#include <thread>
+
+/*
+ * Define `std::partial_sort()` para quedarnos con las K palabras más frecuentes.
+ * Más información -> https://en.cppreference.com/w/cpp/header/algorithm
+ */
+#include <algorithm>
+
+/*
+ * Decodifica el carácter UTF-8 que empieza en `p` (sin pasar de `fin`) y devuelve
+ * su «punto de código». En `len` devuelve los bytes que ocupa. Las secuencias
+ * inválidas se tratan como un único byte con el valor `0xFFFD` (carácter de reemplazo).
+ */
+inline uint32_t decodificaUtf8(const char* p, const char* fin, int& len) {
+    unsigned char c = *p;
+    if (c < 0x80) {
+        len = 1;
+        return c;
+    }
+
+    int n = c >= 0xF0 ? 4 : c >= 0xE0 ? 3 : c >= 0xC0 ? 2 : 0;
+    if (n == 0 || fin - p < n) {
+        len = 1;
+        return 0xFFFD;
+    }
+
+    uint32_t cp = c & (0x7F >> n);
+    for (int i = 1; i < n; i++) {
+        unsigned char sig = p[i];
+        if ((sig & 0xC0) != 0x80) {
+            len = 1;
+            return 0xFFFD;
+        }
+        cp = (cp << 6) | (sig & 0x3F);
+    }
+
+    len = n;
+    return cp;
+}
+
+/*
+ * Indica si un punto de código forma parte de una palabra. Consideramos letras y
+ * números ASCII, las letras de los bloques «Latin-1» y «Latin Extended» (á, ñ, ü, ç...)
+ * y cualquier carácter de otros alfabetos. Los signos de puntuación de Latin-1
+ * (¿, ¡, «, », º...) y la puntuación general (—, “, ”, espacios de ancho cero...)
+ * separan palabras.
+ */
+inline bool esLetra(uint32_t cp) {
+    if (cp < 0x80)
+        return (cp >= '0' && cp <= '9') || ((cp | 0x20) >= 'a' && (cp | 0x20) <= 'z');
+    if (cp < 0xC0)
+        return cp == 0xAA || cp == 0xBA;
+    if (cp <= 0x24F)
+        return cp != 0xD7 && cp != 0xF7;
+    if (cp >= 0x2000 && cp <= 0x2BFF)
+        return false;
+    return cp >= 0x370 && cp != 0xFFFD && cp != 0xFEFF;
+}
+
+/*
+ * Pasa un punto de código a minúsculas. Cubrimos ASCII, Latin-1 (Á -> á, Ñ -> ñ)
+ * y los pares mayúscula/minúscula de Latin Extended-A, que es lo que necesitamos
+ * para textos en castellano y en la mayoría de lenguas europeas occidentales.
+ */
+inline uint32_t minuscula(uint32_t cp) {
+    if (cp >= 'A' && cp <= 'Z')
+        return cp + 0x20;
+    if (cp >= 0xC0 && cp <= 0xDE && cp != 0xD7)
+        return cp + 0x20;
+    if ((cp >= 0x100 && cp <= 0x137) || (cp >= 0x14A && cp <= 0x177))
+        return cp | 1;
+    if ((cp >= 0x139 && cp <= 0x148) || (cp >= 0x179 && cp <= 0x17E))
+        return cp + (cp & 1);
+    // La minúscula de `Ÿ` (Latin Extended-A) es `ÿ`, que está en Latin-1.
+    if (cp == 0x178)
+        return 0xFF;
+    return cp;
+}
+
+// Añade un punto de código a una cadena codificándolo en UTF-8.
+void codificaUtf8(uint32_t cp, std::string& s) {
+    if (cp < 0x80) {
+        s += char(cp);
+    } else if (cp < 0x800) {
+        s += char(0xC0 | (cp >> 6));
+        s += char(0x80 | (cp & 0x3F));
+    } else if (cp < 0x10000) {
+        s += char(0xE0 | (cp >> 12));
+        s += char(0x80 | ((cp >> 6) & 0x3F));
+        s += char(0x80 | (cp & 0x3F));
+    } else {
+        s += char(0xF0 | (cp >> 18));
+        s += char(0x80 | ((cp >> 12) & 0x3F));
+        s += char(0x80 | ((cp >> 6) & 0x3F));
+        s += char(0x80 | (cp & 0x3F));
+    }
+}
+
+// Devuelve la palabra `[p, p + len)` en minúsculas. Solo se usa para mostrar los resultados.
+std::string palabraMinusculas(const char* p, uint32_t len) {
+    std::string s;
+    const char* fin = p + len;
+    int n;
+    while (p < fin) {
+        codificaUtf8(minuscula(decodificaUtf8(p, fin, n)), s);
+        p += n;
+    }
+    return s;
+}
+
+// Compara dos palabras sin distinguir mayúsculas de minúsculas.
+bool mismaPalabra(const char* a, uint32_t lenA, const char* b, uint32_t lenB) {
+    const char *finA = a + lenA, *finB = b + lenB;
+    int na, nb;
+    while (a < finA && b < finB) {
+        if (minuscula(decodificaUtf8(a, finA, na)) != minuscula(decodificaUtf8(b, finB, nb)))
+            return false;
+        a += na;
+        b += nb;
+    }
+    return a == finA && b == finB;
+}
+
+/*
+ * Cada entrada de la tabla guarda el hash de la palabra para descartar casi todas
+ * las comparaciones sin mirar el texto, una vista a su primera aparición y su cuenta.
+ * Las posiciones libres tienen `cuenta == 0`.
+ */
+struct EntradaFrecuencia {
+    uint64_t hash;
+    const char* palabra;
+    uint32_t len;
+    uint64_t cuenta;
+};
+
+struct TablaFrecuencias {
+    std::vector<EntradaFrecuencia> entradas;
+    size_t ocupadas;
+};
+
+TablaFrecuencias creaTabla(size_t capacidad = 1024) {
+    // La capacidad siempre es una potencia de 2 para poder usar `hash & (capacidad - 1)` en vez de `%`.
+    size_t c = 16;
+    while (c < capacidad)
+        c *= 2;
+    EntradaFrecuencia vacia = {0, NULL, 0, 0};
+    TablaFrecuencias t = {std::vector<EntradaFrecuencia>(c, vacia), 0};
+    return t;
+}
+
+void insertaEntrada(TablaFrecuencias& t, EntradaFrecuencia const& e);
+
+// Duplica la capacidad de la tabla y recoloca todas las entradas.
+void agrandaTabla(TablaFrecuencias& t) {
+    TablaFrecuencias nueva = creaTabla(t.entradas.size() * 2);
+    for (EntradaFrecuencia const& e : t.entradas)
+        if (e.cuenta)
+            insertaEntrada(nueva, e);
+    t.entradas.swap(nueva.entradas);
+    t.ocupadas = nueva.ocupadas;
+}
+
+/*
+ * Suma `e.cuenta` apariciones a la palabra de `e`. Si la palabra ya estaba nos
+ * quedamos con la aparición que esté antes en el texto (la de menor dirección) para
+ * que el resultado no dependa del número de hilos.
+ */
+void insertaEntrada(TablaFrecuencias& t, EntradaFrecuencia const& e) {
+    // Mantenemos al menos la mitad de la tabla libre para que las búsquedas sean cortas.
+    if (2 * (t.ocupadas + 1) > t.entradas.size())
+        agrandaTabla(t);
+
+    size_t mascara = t.entradas.size() - 1;
+    for (size_t i = e.hash & mascara;; i = (i + 1) & mascara) {
+        EntradaFrecuencia& actual = t.entradas[i];
+        if (actual.cuenta == 0) {
+            actual = e;
+            t.ocupadas++;
+            return;
+        }
+        if (actual.hash == e.hash && mismaPalabra(actual.palabra, actual.len, e.palabra, e.len)) {
+            actual.cuenta += e.cuenta;
+            if (e.palabra < actual.palabra) {
+                actual.palabra = e.palabra;
+                actual.len = e.len;
+            }
+            return;
+        }
+    }
+}
+
+/*
+ * Recorre las palabras que *empiezan* en `[ini, fin)` de un texto que acaba en
+ * `finTexto` y las cuenta en `t`. La última palabra puede terminar más allá de `fin`.
+ * Si `ini` cae en mitad de una palabra la saltamos: la contará quien procese el
+ * trozo anterior.
+ */
+void cuentaFrecuencias(TablaFrecuencias& t, const char* texto, const char* ini, const char* fin, const char* finTexto) {
+    const char* p = ini;
+    int n;
+
+    // Nos colocamos al comienzo de un carácter UTF-8 (los bytes de continuación son `10xxxxxx`).
+    while (p < finTexto && (*p & 0xC0) == 0x80)
+        p++;
+
+    if (p > texto) {
+        // Buscamos el comienzo del carácter anterior para saber si estamos en mitad de una palabra.
+        const char* q = p - 1;
+        while (q > texto && (*q & 0xC0) == 0x80)
+            q--;
+        if (esLetra(decodificaUtf8(q, finTexto, n)))
+            while (p < finTexto && esLetra(decodificaUtf8(p, finTexto, n)))
+                p += n;
+    }
+
+    while (p < fin) {
+        uint32_t cp = decodificaUtf8(p, finTexto, n);
+        if (!esLetra(cp)) {
+            p += n;
+            continue;
+        }
+
+        // Calculamos el hash FNV-1a de la palabra en minúsculas mientras la recorremos.
+        const char* inicio = p;
+        uint64_t hash = 14695981039346656037ULL;
+        do {
+            hash = (hash ^ minuscula(cp)) * 1099511628211ULL;
+            p += n;
+        } while (p < finTexto && esLetra(cp = decodificaUtf8(p, finTexto, n)));
+
+        EntradaFrecuencia e = {hash, inicio, uint32_t(p - inicio), 1};
+        insertaEntrada(t, e);
+    }
+}
+
+/*
+ * Cuenta las frecuencias de todo el texto `[texto, texto + tam)` con `hilos` hilos
+ * (`0` para usar todos los núcleos), cada uno con su propia tabla, y las combina.
+ */
+TablaFrecuencias cuentaFrecuenciasParalelo(const char* texto, size_t tam, unsigned hilos) {
+    if (hilos == 0)
+        hilos = std::thread::hardware_concurrency();
+    if (hilos == 0)
+        hilos = 1;
+    // No merece la pena lanzar hilos para trozos de menos de 1 MiB.
+    if (tam / hilos < (1 << 20))
+        hilos = tam / (1 << 20) + 1;
+
+    std::vector<TablaFrecuencias> locales(hilos);
+    std::vector<std::thread> trabajadores;
+    size_t tramo = tam / hilos;
+
+    for (unsigned h = 0; h < hilos; h++) {
+        size_t ini = h * tramo, fin = (h == hilos - 1) ? tam : ini + tramo;
+        trabajadores.push_back(std::thread([=, &locales]() {
+            locales[h] = creaTabla();
+            cuentaFrecuencias(locales[h], texto, texto + ini, texto + fin, texto + tam);
+        }));
+    }
+
+    for (unsigned h = 0; h < hilos; h++)
+        trabajadores[h].join();
+
+    // Combinamos todas las tablas en la primera.
+    for (unsigned h = 1; h < hilos; h++) {
+        for (EntradaFrecuencia const& e : locales[h].entradas)
+            if (e.cuenta)
+                insertaEntrada(locales[0], e);
+        locales[h] = TablaFrecuencias();
+    }
+
+    return locales[0];
+}
+
+/*
+ * Devuelve las `k` palabras más frecuentes de mayor a menor frecuencia. Los empates
+ * se resuelven por orden de aparición en el texto.
+ */
+std::vector<EntradaFrecuencia> masFrecuentes(TablaFrecuencias const& t, size_t k) {
+    std::vector<EntradaFrecuencia> todas;
+    for (EntradaFrecuencia const& e : t.entradas)
+        if (e.cuenta)
+            todas.push_back(e);
+
+    k = std::min(k, todas.size());
+    std::partial_sort(todas.begin(), todas.begin() + k, todas.end(),
+                      [](EntradaFrecuencia const& a, EntradaFrecuencia const& b) {
+                          return a.cuenta != b.cuenta ? a.cuenta > b.cuenta : a.palabra < b.palabra;
+                      });
+    todas.resize(k);
+    return todas;
+}
@@ -0,0 +1,361 @@
+/*
+ * Este archivo no contiene un `main()`: implementa una «tubería» (i.e. *pipeline*)
+ * de procesado de texto en cuatro etapas, cada una en su propio hilo:
+ *
+ *      lector -> separador -> filtro -> escritor
+ *
+ *  - Lector: lee el archivo por bloques («lotes») con `leeBloque()` de `archivoMapeado.cpp`.
+ *    Cada lote termina en un espacio en blanco: si la última palabra queda cortada la
+ *    pasa al siguiente.
+ *  - Separador: localiza las palabras del lote y guarda su posición y longitud.
+ *  - Filtro: decide qué palabras se quedan con una función que proporciona el usuario.
+ *  - Escritor: escribe las palabras seleccionadas con el escritor de `escritorBuffer.cpp`
+ *    y devuelve el lote vacío al lector para reutilizarlo.
+ *
+ * Mientras el lector espera al disco el separador ya está trabajando con el lote
+ * anterior, con lo que la entrada/salida y el cálculo se solapan. Las etapas se
+ * comunican con colas circulares de un productor y un consumidor (SPSC) sin
+ * candados (i.e. *lock-free*): al haber un único hilo que escribe y uno que lee
+ * basta con dos índices atómicos para coordinarse.
+ * Más información -> https://en.cppreference.com/w/cpp/atomic/atomic
+ *
+ * `cuentaPalabrasTuberia.cpp` y `seleccionPalabrasTuberia.cpp` son dos ejemplos
+ * de configuración de esta tubería.
+ */
+
+/*
+ * Define `std::atomic`, variables que varios hilos pueden leer y escribir a la vez
+ * de forma segura.
+ * Más información -> https://en.cppreference.com/w/cpp/header/atomic
+ */
+#include <atomic>
+
+/*
+ * Define `std::max()` y `std::copy()`.
+ * Más información -> https://en.cppreference.com/w/cpp/header/algorithm
+ */
+#include <algorithm>
+
+/*
+ * Define `std::chrono::steady_clock` para medir el tiempo ocupado de cada etapa.
+ * Más información -> https://en.cppreference.com/w/cpp/header/chrono
+ */
+#include <chrono>
+
+/*
+ * Define `uint32_t`, con el que guardamos la posición de cada palabra en su lote.
+ * Más información -> https://en.cppreference.com/w/cpp/header/cstdint
+ */
+#include <cstdint>
+
+/*
+ * Define `std::string` para los nombres de las etapas y las colas.
+ * Más información -> https://en.cppreference.com/w/cpp/header/string
+ */
+#include <string>
+
+/*
+ * Define `std::thread` para ejecutar cada etapa en su propio hilo.
+ * Más información -> https://en.cppreference.com/w/cpp/header/thread
+ */
+#include <thread>
+
+/*
+ * Define `std::vector`, donde viven los lotes y los elementos de las colas.
+ * Más información -> https://en.cppreference.com/w/cpp/header/vector
+ */
+#include <vector>
+
+// También incluye `archivoMapeado.cpp`, de donde tomamos `esEspacio()`.
+#include "contadorPalabras.cpp"
+#include "escritorBuffer.cpp"
+
+/*
+ * Cola circular de capacidad fija (potencia de 2) para un productor y un consumidor.
+ * `cabeza` solo la modifica el consumidor y `cola` solo el productor. Las colocamos
+ * en líneas de caché distintas (64 bytes) para que los dos hilos no se «pisen».
+ * También recogemos la ocupación de la cola cada vez que se inserta un elemento.
+ */
+template <typename T>
+struct ColaSPSC {
+    std::vector<T> elementos;
+    size_t mascara;
+    alignas(64) std::atomic<size_t> cabeza;
+    alignas(64) std::atomic<size_t> cola;
+    // Estadísticas de ocupación; solo las modifica el productor.
+    size_t inserciones, ocupacionTotal, ocupacionMaxima;
+
+    explicit ColaSPSC(size_t capacidad) : cabeza(0), cola(0), inserciones(0), ocupacionTotal(0), ocupacionMaxima(0) {
+        size_t c = 2;
+        while (c < capacidad)
+            c *= 2;
+        elementos.resize(c);
+        mascara = c - 1;
+    }
+
+    bool intentaInsertar(T const& e) {
+        size_t t = cola.load(std::memory_order_relaxed);
+        size_t ocupacion = t - cabeza.load(std::memory_order_acquire);
+        if (ocupacion > mascara)
+            return false;
+        elementos[t & mascara] = e;
+        // `release` garantiza que el consumidor verá el elemento antes que el nuevo índice.
+        cola.store(t + 1, std::memory_order_release);
+
+        inserciones++;
+        ocupacionTotal += ocupacion + 1;
+        ocupacionMaxima = std::max(ocupacionMaxima, ocupacion + 1);
+        return true;
+    }
+
+    bool intentaExtraer(T& e) {
+        size_t h = cabeza.load(std::memory_order_relaxed);
+        if (h == cola.load(std::memory_order_acquire))
+            return false;
+        e = elementos[h & mascara];
+        cabeza.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Versiones que esperan cediendo el procesador a otros hilos mientras la cola esté llena o vacía.
+    void inserta(T const& e) {
+        while (!intentaInsertar(e))
+            std::this_thread::yield();
+    }
+
+    T extrae() {
+        T e;
+        while (!intentaExtraer(e))
+            std::this_thread::yield();
+        return e;
+    }
+};
+
+// Una palabra dentro de un lote: desplazamiento desde el comienzo y longitud.
+struct Fragmento {
+    uint32_t inicio, len;
+};
+
+/*
+ * Un lote de texto junto con las palabras que contiene. Los lotes se reservan una
+ * única vez y circulan por la tubería: cuando el escritor termina con uno se lo
+ * devuelve al lector. Un puntero `NULL` indica el final de los datos.
+ */
+struct Lote {
+    std::vector<char> datos;
+    size_t usado;
+    std::vector<Fragmento> palabras;
+};
+
+struct ConfigTuberia {
+    // Descriptor del que leer y al que escribir. Con `fdSalida < 0` no se escribe nada.
+    int fdEntrada, fdSalida;
+    // Tamaño de cada lote y número de lotes en circulación.
+    size_t tamLote, lotes;
+};
+
+ConfigTuberia configTuberia(int fdEntrada, int fdSalida) {
+    ConfigTuberia c = {fdEntrada, fdSalida, 1 << 18, 16};
+    return c;
+}
+
+// Lo que ha hecho cada etapa: elementos (bytes o palabras) procesados y tiempo ocupado (sin contar esperas).
+struct EstadisticasEtapa {
+    std::string nombre, unidad;
+    double elementos, segundos;
+};
+
+struct EstadisticasCola {
+    std::string nombre;
+    size_t capacidad;
+    double ocupacionMedia;
+    size_t ocupacionMaxima;
+};
+
+struct EstadisticasTuberia {
+    long palabras, seleccionadas;
+    bool error;
+    double segundos;
+    std::vector<EstadisticasEtapa> etapas;
+    std::vector<EstadisticasCola> colas;
+};
+
+typedef std::chrono::steady_clock Reloj;
+
+inline double segundosDesde(Reloj::time_point t0) {
+    return std::chrono::duration<double>(Reloj::now() - t0).count();
+}
+
+template <typename T>
+EstadisticasCola estadisticasCola(std::string const& nombre, ColaSPSC<T> const& c) {
+    EstadisticasCola e = {nombre, c.mascara + 1, c.inserciones ? double(c.ocupacionTotal) / c.inserciones : 0,
+                          c.ocupacionMaxima};
+    return e;
+}
+
+/*
+ * Ejecuta la tubería. `filtro(texto, len, posicion)` se llama para cada palabra en
+ * orden (la primera tiene posición 1) y devuelve `true` si hay que escribirla. Es
+ * una plantilla para que el compilador pueda insertar el filtro en el bucle.
+ */
+template <typename F>
+EstadisticasTuberia ejecutaTuberia(ConfigTuberia const& config, F filtro) {
+    std::vector<Lote> lotes(config.lotes);
+    ColaSPSC<Lote*> libres(config.lotes), leidos(config.lotes), separados(config.lotes), filtrados(config.lotes);
+    for (Lote& l : lotes) {
+        l.datos.resize(config.tamLote);
+        l.usado = 0;
+        libres.inserta(&l);
+    }
+
+    EstadisticasTuberia est = {0, 0, false, 0, std::vector<EstadisticasEtapa>(4), std::vector<EstadisticasCola>()};
+    std::atomic<bool> errorLectura(false), errorEscritura(false);
+    Reloj::time_point inicio = Reloj::now();
+
+    std::thread lector([&]() {
+        EstadisticasEtapa& e = est.etapas[0];
+        e.nombre = "lector";
+        e.unidad = "MB";
+        std::vector<char> arrastre;
+        bool fin = false;
+        // `leeBloque()` solo necesita el descriptor: la entrada no está proyectada.
+        ArchivoMapeado entrada = {config.fdEntrada, NULL, 0};
+
+        while (!fin) {
+            Lote* l = libres.extrae();
+            Reloj::time_point t0 = Reloj::now();
+
+            /*
+             * Empezamos el lote con el trozo de palabra que quedó cortado en el anterior.
+             * Si una palabra no cabe en un lote, lo agrandamos para que siempre quede sitio.
+             */
+            if (arrastre.size() >= l->datos.size())
+                l->datos.resize(arrastre.size() * 2);
+            std::copy(arrastre.begin(), arrastre.end(), l->datos.begin());
+            l->usado = arrastre.size();
+            arrastre.clear();
+
+            while (l->usado < l->datos.size()) {
+                long n = leeBloque(entrada, l->datos.data() + l->usado, l->datos.size() - l->usado);
+                if (n <= 0) {
+                    errorLectura = n < 0;
+                    fin = true;
+                    break;
+                }
+                l->usado += n;
+                e.elementos += n / 1e6;
+            }
+
+            // Si no hemos llegado al final, apartamos la última palabra (quizás incompleta) para el siguiente lote.
+            if (!fin) {
+                size_t corte = l->usado;
+                while (corte > 0 && !esEspacio(l->datos[corte - 1]))
+                    corte--;
+                arrastre.assign(l->datos.begin() + corte, l->datos.begin() + l->usado);
+                l->usado = corte;
+            }
+
+            e.segundos += segundosDesde(t0);
+            leidos.inserta(l);
+        }
+        leidos.inserta(NULL);
+    });
+
+    std::thread separador([&]() {
+        EstadisticasEtapa& e = est.etapas[1];
+        e.nombre = "separador";
+        e.unidad = "MB";
+        Lote* l;
+        while ((l = leidos.extrae()) != NULL) {
+            Reloj::time_point t0 = Reloj::now();
+            l->palabras.clear();
+            const char *base = l->datos.data(), *p = base, *fin = base + l->usado;
+            while (p < fin) {
+                while (p < fin && esEspacio(*p))
+                    p++;
+                const char* ini = p;
+                while (p < fin && !esEspacio(*p))
+                    p++;
+                if (p > ini) {
+                    Fragmento f = {uint32_t(ini - base), uint32_t(p - ini)};
+                    l->palabras.push_back(f);
+                }
+            }
+            e.elementos += l->usado / 1e6;
+            e.segundos += segundosDesde(t0);
+            separados.inserta(l);
+        }
+        separados.inserta(NULL);
+    });
+
+    std::thread etapaFiltro([&]() {
+        EstadisticasEtapa& e = est.etapas[2];
+        e.nombre = "filtro";
+        e.unidad = "Mpalabras";
+        Lote* l;
+        while ((l = separados.extrae()) != NULL) {
+            Reloj::time_point t0 = Reloj::now();
+            // Compactamos en el sitio las palabras que pasan el filtro.
+            size_t quedan = 0;
+            for (Fragmento const& f : l->palabras)
+                if (filtro(l->datos.data() + f.inicio, size_t(f.len), ++est.palabras))
+                    l->palabras[quedan++] = f;
+            e.elementos += l->palabras.size() / 1e6;
+            l->palabras.resize(quedan);
+            est.seleccionadas += quedan;
+            e.segundos += segundosDesde(t0);
+            filtrados.inserta(l);
+        }
+        filtrados.inserta(NULL);
+    });
+
+    std::thread escritor([&]() {
+        EstadisticasEtapa& e = est.etapas[3];
+        e.nombre = "escritor";
+        e.unidad = "MB";
+        EscritorBuffer salida = creaEscritor(config.fdSalida);
+        Lote* l;
+        while ((l = filtrados.extrae()) != NULL) {
+            Reloj::time_point t0 = Reloj::now();
+            // Tras un error dejamos de escribir pero seguimos devolviendo lotes para que la tubería termine.
+            if (config.fdSalida >= 0 && !salida.error) {
+                for (Fragmento const& f : l->palabras)
+                    if (!escribe(salida, l->datos.data() + f.inicio, f.len) || !escribe(salida, '\n'))
+                        break;
+            }
+            e.segundos += segundosDesde(t0);
+            libres.inserta(l);
+        }
+        if (config.fdSalida >= 0) {
+            Reloj::time_point t0 = Reloj::now();
+            errorEscritura = !vuelcaEscritor(salida);
+            e.segundos += segundosDesde(t0);
+        }
+        e.elementos = salida.bytesEscritos / 1e6;
+    });
+
+    lector.join();
+    separador.join();
+    etapaFiltro.join();
+    escritor.join();
+
+    est.segundos = segundosDesde(inicio);
+    est.error = errorLectura || errorEscritura;
+    est.colas.push_back(estadisticasCola("lector -> separador", leidos));
+    est.colas.push_back(estadisticasCola("separador -> filtro", separados));
+    est.colas.push_back(estadisticasCola("filtro -> escritor", filtrados));
+    est.colas.push_back(estadisticasCola("escritor -> lector", libres));
+    return est;
+}
+
+// Muestra por `salida` el rendimiento de cada etapa y la ocupación de cada cola.
+void muestraEstadisticas(std::ostream& salida, EstadisticasTuberia const& est) {
+    salida << "Tubería: " << est.palabras << " palabras, " << est.seleccionadas << " seleccionadas en "
+           << est.segundos << " s\n";
+    for (EstadisticasEtapa const& e : est.etapas)
+        salida << "\tetapa " << e.nombre << ": " << e.elementos << " " << e.unidad << " en " << e.segundos
+               << " s ocupada (" << (e.segundos > 0 ? e.elementos / e.segundos : 0) << " " << e.unidad << "/s)\n";
+    for (EstadisticasCola const& c : est.colas)
+        salida << "\tcola " << c.nombre << ": ocupación media " << c.ocupacionMedia << ", máxima "
+               << c.ocupacionMaxima << " de " << c.capacidad << "\n";
+}
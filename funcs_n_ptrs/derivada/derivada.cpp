@@ -1,4 +1,9 @@
-double derivada(double f(double), double x, int mode, double h) {
+/*
+ * `f` puede ser cualquier objeto «invocable»: un puntero a función, una lambda, un
+ * functor o un `std::function`. Ver la explicación de `integral()` en `integral/integral.cpp`.
+ */
+template <typename F>
+double derivada(F f, double x, int mode, double h) {
     switch (mode) {
         case 0:
             return (f(x + h) - f(x)) / h;
@@ -8,11 +13,18 @@ double derivada(double f(double), double x, int mode, double h) {
             return (8 * f(x + h) - 8 * f(x - h) - f(x + 2 * h) + f( x - 2 * h)) / (12 * h);
         case 3:
             {
-                double s = (8 * f(x + h) - 8 * f(x - h) - f(x + 2 * h) + f(x - 2 * h)) / (12 * h);
-                double s2 = (8 * f(x + 2 * h) - 8 * f(x - 2 * h) - f(x + 4 * h) + f(x - 4 * h)) / (24 * h);
+                // `f(x + 2h)` y `f(x - 2h)` aparecen en ambas fórmulas: las evaluamos una sola vez.
+                double f2 = f(x + 2 * h), fm2 = f(x - 2 * h);
+                double s = (8 * f(x + h) - 8 * f(x - h) - f2 + fm2) / (12 * h);
+                double s2 = (8 * f2 - 8 * fm2 - f(x + 4 * h) + f(x - 4 * h)) / (24 * h);
                 return (16 * s - s2) / 15;
             }
         default:
             return 0.0;
     }
 }
+
+// Sin esta versión no podríamos pasar funciones sobrecargadas como `sin`: la plantilla no sabría cuál elegir.
+double derivada(double f(double), double x, int mode, double h) {
+    return derivada<double (*)(double)>(f, x, mode, h);
+}
@@ -0,0 +1,199 @@
+/*
+ * Derivación numérica sin tener que elegir `h` a mano. El problema de `derivada()` es
+ * que con `h` grande domina el error de truncamiento y con `h` pequeño el de redondeo
+ * (restamos dos números casi iguales), y el punto óptimo depende de la función.
+ *
+ * Usamos el método de Ridders: calculamos la diferencia central con pasos decrecientes
+ * `h, h / C, h / C^2, ...` y extrapolamos a `h = 0` con una tabla de Richardson. Cada
+ * fila nueva de la tabla solo necesita las dos evaluaciones de la diferencia central
+ * con el paso nuevo; el resto de entradas se combinan a partir de las ya calculadas. En
+ * cada paso nos quedamos con la entrada de menor error estimado y paramos en cuanto el
+ * error empieza a crecer (el redondeo ya domina) o baja de la tolerancia pedida.
+ * Más información -> https://en.wikipedia.org/wiki/Ridders%27_method y
+ * Numerical Recipes, §5.7.
+ *
+ * La misma tabla sirve para funciones con varias salidas, con lo que extendemos el
+ * método a gradientes y jacobianas, repartiendo las coordenadas entre varios hilos.
+ */
+
+#include <cmath>
+#include <thread>
+#include <vector>
+
+// Factor de reducción del paso, número máximo de filas de la tabla y margen para cortar.
+#define REDUCCION_PASO 1.4
+#define MAX_FILAS_RICHARDSON 10
+#define MARGEN_RICHARDSON 2.0
+// Paso inicial relativo a `max(|x|, 1)`: no tiene por qué ser pequeño, la extrapolación se encarga.
+#define PASO_INICIAL 0.1
+
+struct ResultadoDerivada {
+    double valor, error;
+    long evaluaciones;
+};
+
+/*
+ * Extrapolación de Ridders para `m` salidas a la vez. `diferencia(h, d)` escribe en
+ * `d[0..m-1]` las diferencias centrales con paso `h` y devuelve cuántas evaluaciones
+ * ha hecho. Deja en `valor` y `error` la mejor estimación (las decisiones se toman con
+ * el mayor error de todas las salidas) y devuelve el total de evaluaciones.
+ */
+template <typename D>
+long extrapolaRidders(D diferencia, int m, double h, double tolerancia, double* valor, double* error) {
+    // tabla[(i * MAX_FILAS_RICHARDSON + j) * m + k]: salida `k`, paso `i`, orden de extrapolación `j`.
+    std::vector<double> tabla(MAX_FILAS_RICHARDSON * MAX_FILAS_RICHARDSON * m);
+    double* t = tabla.data(), mejor = HUGE_VAL;
+    long evaluaciones = diferencia(h, t);
+    for (int k = 0; k < m; k++) {
+        valor[k] = t[k];
+        error[k] = HUGE_VAL;
+    }
+
+    for (int i = 1; i < MAX_FILAS_RICHARDSON; i++) {
+        h /= REDUCCION_PASO;
+        double* fila = t + i * MAX_FILAS_RICHARDSON * m;
+        double* anterior = fila - MAX_FILAS_RICHARDSON * m;
+        evaluaciones += diferencia(h, fila);
+
+        // El error de la diferencia central va con `h^2`: cada orden elimina una potencia más.
+        double factor = REDUCCION_PASO * REDUCCION_PASO;
+        for (int j = 1; j <= i; j++, factor *= REDUCCION_PASO * REDUCCION_PASO) {
+            double estimado = 0;
+            for (int k = 0; k < m; k++) {
+                double nuevo = (fila[(j - 1) * m + k] * factor - anterior[(j - 1) * m + k]) / (factor - 1);
+                fila[j * m + k] = nuevo;
+                estimado = std::fmax(estimado, std::fmax(std::fabs(nuevo - fila[(j - 1) * m + k]),
+                                                         std::fabs(nuevo - anterior[(j - 1) * m + k])));
+            }
+            if (estimado <= mejor) {
+                mejor = estimado;
+                for (int k = 0; k < m; k++) {
+                    valor[k] = fila[j * m + k];
+                    error[k] = estimado;
+                }
+            }
+        }
+
+        // Si la diagonal se aleja más que el error actual, el redondeo ya domina: no merece la pena seguir.
+        double salto = 0;
+        for (int k = 0; k < m; k++)
+            salto = std::fmax(salto, std::fabs(fila[i * m + k] - anterior[(i - 1) * m + k]));
+        if (salto >= MARGEN_RICHARDSON * mejor || mejor < tolerancia)
+            break;
+    }
+    return evaluaciones;
+}
+
+inline double pasoInicial(double x) {
+    return PASO_INICIAL * std::fmax(std::fabs(x), 1.0);
+}
+
+// Derivada de `f` en `x` con paso y orden elegidos automáticamente.
+template <typename F>
+ResultadoDerivada derivadaRidders(F f, double x, double tolerancia = 0) {
+    ResultadoDerivada r = {0, 0, 0};
+    r.evaluaciones = extrapolaRidders([&](double h, double* d) -> long {
+        d[0] = (f(x + h) - f(x - h)) / (2 * h);
+        return 2L;
+    }, 1, pasoInicial(x), tolerancia, &r.valor, &r.error);
+    return r;
+}
+
+// Sin esta versión no podríamos pasar funciones sobrecargadas como `sin`, igual que con `derivada()`.
+ResultadoDerivada derivadaRidders(double f(double), double x, double tolerancia = 0) {
+    return derivadaRidders<double (*)(double)>(f, x, tolerancia);
+}
+
+/*
+ * Reparte las columnas `0..n-1` entre `hilos` hilos (`0` usa todos los núcleos):
+ * el hilo `t` calcula las columnas `t`, `t + hilos`... llamando a `columna(j)`.
+ * Para compilar hay que pasar `-pthread` a `g++`.
+ */
+template <typename C>
+void repartePorColumnas(C columna, int n, unsigned hilos) {
+    if (hilos == 0)
+        hilos = std::thread::hardware_concurrency();
+    if (hilos <= 1 || n == 1) {
+        for (int j = 0; j < n; j++)
+            columna(j);
+        return;
+    }
+
+    std::vector<std::thread> trabajadores;
+    for (unsigned t = 0; t < hilos && (int) t < n; t++)
+        trabajadores.push_back(std::thread([=]() {
+            for (int j = t; j < n; j += hilos)
+                columna(j);
+        }));
+    for (unsigned t = 0; t < trabajadores.size(); t++)
+        trabajadores[t].join();
+}
+
+/*
+ * Gradiente de `f(const double* x)` en el punto `x` de `n` dimensiones: cada derivada
+ * parcial es una derivada de Ridders moviendo solo la coordenada `j`. Cada hilo trabaja
+ * sobre su propia copia de `x`. Devuelve el total de evaluaciones.
+ */
+template <typename F>
+long gradiente(F f, const double* x, int n, double* grad, double* error = nullptr,
+               double tolerancia = 0, unsigned hilos = 0) {
+    std::vector<long> evaluaciones(n);
+    std::vector<double> errores(n);
+    repartePorColumnas([&](int j) {
+        std::vector<double> y(x, x + n);
+        evaluaciones[j] = extrapolaRidders([&](double h, double* d) -> long {
+            y[j] = x[j] + h;
+            double mas = f(y.data());
+            y[j] = x[j] - h;
+            double menos = f(y.data());
+            y[j] = x[j];
+            d[0] = (mas - menos) / (2 * h);
+            return 2L;
+        }, 1, pasoInicial(x[j]), tolerancia, grad + j, errores.data() + j);
+    }, n, hilos);
+
+    long total = 0;
+    for (int j = 0; j < n; j++) {
+        total += evaluaciones[j];
+        if (error)
+            error[j] = errores[j];
+    }
+    return total;
+}
+
+/*
+ * Jacobiana de `f(const double* x, double* y)`, que lleva `x` (de `n` componentes) a
+ * `y` (de `m`). La columna `j` (las derivadas de todas las salidas respecto a `x_j`)
+ * sale de una sola tabla de Richardson, con lo que cada paso cuesta dos evaluaciones
+ * de `f` para las `m` salidas. `jac` se guarda por filas: `jac[i * n + j] = dy_i / dx_j`.
+ */
+template <typename F>
+long jacobiana(F f, const double* x, int n, int m, double* jac, double* error = nullptr,
+               double tolerancia = 0, unsigned hilos = 0) {
+    std::vector<long> evaluaciones(n);
+    std::vector<double> columnas(n * m), errores(n * m);
+    repartePorColumnas([&](int j) {
+        std::vector<double> y(x, x + n), mas(m), menos(m);
+        evaluaciones[j] = extrapolaRidders([&](double h, double* d) -> long {
+            y[j] = x[j] + h;
+            f(y.data(), mas.data());
+            y[j] = x[j] - h;
+            f(y.data(), menos.data());
+            y[j] = x[j];
+            for (int i = 0; i < m; i++)
+                d[i] = (mas[i] - menos[i]) / (2 * h);
+            return 2L;
+        }, m, pasoInicial(x[j]), tolerancia, columnas.data() + j * m, errores.data() + j * m);
+    }, n, hilos);
+
+    long total = 0;
+    for (int j = 0; j < n; j++) {
+        total += evaluaciones[j];
+        for (int i = 0; i < m; i++) {
+            jac[i * n + j] = columnas[j * m + i];
+            if (error)
+                error[i * n + j] = errores[j * m + i];
+        }
+    }
+    return total;
+}
@@ -0,0 +1,169 @@
+/*
+ * Diferenciación automática «hacia delante» con números duales. Un dual es
+ * `a + b e` con `e^2 = 0`, con lo que al desarrollar en serie de Taylor
+ *      f(x + e) = f(x) + f'(x) e
+ * es decir: si evaluamos `f` sobre el dual `x + 1 e` la parte `e` del resultado es
+ * exactamente `f'(x)`. Solo hay que definir las operaciones y funciones elementales
+ * aplicando la regla de la cadena a la parte `e`, y cualquier integrando escrito como
+ * plantilla (`template <typename T> T f(T x)`) sirve tanto para `double` como para duales.
+ * A diferencia de `derivada()` no hay ningún `h`: no hay error de truncamiento ni de
+ * cancelación y el coste es el de una evaluación (algo más cara).
+ *  - `Dual`: valor y primera derivada.
+ *  - `HiperDual`: `a + b e1 + c e2 + d e1 e2` con `e1^2 = e2^2 = 0`. La parte `e1 e2`
+ *    de `f(x + e1 + e2)` es `f''(x)`.
+ *  - `DualVector<N>`: `N` partes `e` a la vez, i.e. `N` derivadas direccionales (o un
+ *    gradiente de `N` componentes) en una sola evaluación. Las partes `e` se guardan
+ *    en un array y todas las operaciones son bucles sobre él que el compilador vectoriza.
+ * Más información -> https://en.wikipedia.org/wiki/Automatic_differentiation y
+ * https://en.wikipedia.org/wiki/Dual_number
+ */
+
+#include <cmath>
+#include <vector>
+
+struct Dual {
+    double v, d;
+    Dual(double valor = 0, double derivada = 0) : v(valor), d(derivada) {}
+};
+
+inline Dual operator+(Dual a, Dual b) { return Dual(a.v + b.v, a.d + b.d); }
+inline Dual operator-(Dual a, Dual b) { return Dual(a.v - b.v, a.d - b.d); }
+inline Dual operator-(Dual a) { return Dual(-a.v, -a.d); }
+inline Dual operator*(Dual a, Dual b) { return Dual(a.v * b.v, a.d * b.v + a.v * b.d); }
+inline Dual operator/(Dual a, Dual b) { return Dual(a.v / b.v, (a.d * b.v - a.v * b.d) / (b.v * b.v)); }
+
+// Regla de la cadena: `g(a + b e) = g(a) + g'(a) b e`.
+inline Dual exp(Dual a) { double e = std::exp(a.v); return Dual(e, e * a.d); }
+inline Dual log(Dual a) { return Dual(std::log(a.v), a.d / a.v); }
+inline Dual sin(Dual a) { return Dual(std::sin(a.v), std::cos(a.v) * a.d); }
+inline Dual cos(Dual a) { return Dual(std::cos(a.v), -std::sin(a.v) * a.d); }
+inline Dual sqrt(Dual a) { double s = std::sqrt(a.v); return Dual(s, a.d / (2 * s)); }
+inline Dual pow(Dual a, double p) { return Dual(std::pow(a.v, p), p * std::pow(a.v, p - 1) * a.d); }
+
+struct HiperDual {
+    double v, d1, d2, d12;
+    HiperDual(double valor = 0, double e1 = 0, double e2 = 0, double e12 = 0) : v(valor), d1(e1), d2(e2), d12(e12) {}
+};
+
+/*
+ * Para una función elemental `g`, `g(a + b e1 + c e2 + d e1 e2)` vale
+ *      g(a) + g'(a) b e1 + g'(a) c e2 + (g'(a) d + g''(a) b c) e1 e2
+ */
+inline HiperDual aplica(HiperDual a, double g, double g1, double g2) {
+    return HiperDual(g, g1 * a.d1, g1 * a.d2, g1 * a.d12 + g2 * a.d1 * a.d2);
+}
+
+inline HiperDual operator+(HiperDual a, HiperDual b) { return HiperDual(a.v + b.v, a.d1 + b.d1, a.d2 + b.d2, a.d12 + b.d12); }
+inline HiperDual operator-(HiperDual a, HiperDual b) { return HiperDual(a.v - b.v, a.d1 - b.d1, a.d2 - b.d2, a.d12 - b.d12); }
+inline HiperDual operator-(HiperDual a) { return HiperDual(-a.v, -a.d1, -a.d2, -a.d12); }
+inline HiperDual operator*(HiperDual a, HiperDual b) {
+    return HiperDual(a.v * b.v, a.d1 * b.v + a.v * b.d1, a.d2 * b.v + a.v * b.d2,
+                     a.d12 * b.v + a.d1 * b.d2 + a.d2 * b.d1 + a.v * b.d12);
+}
+inline HiperDual operator/(HiperDual a, HiperDual b) {
+    double inv = 1 / b.v;
+    return a * aplica(b, inv, -inv * inv, 2 * inv * inv * inv);
+}
+
+inline HiperDual exp(HiperDual a) { double e = std::exp(a.v); return aplica(a, e, e, e); }
+inline HiperDual log(HiperDual a) { return aplica(a, std::log(a.v), 1 / a.v, -1 / (a.v * a.v)); }
+inline HiperDual sin(HiperDual a) { double s = std::sin(a.v); return aplica(a, s, std::cos(a.v), -s); }
+inline HiperDual cos(HiperDual a) { double c = std::cos(a.v); return aplica(a, c, -std::sin(a.v), -c); }
+inline HiperDual sqrt(HiperDual a) { double s = std::sqrt(a.v); return aplica(a, s, 1 / (2 * s), -1 / (4 * s * a.v)); }
+inline HiperDual pow(HiperDual a, double p) {
+    return aplica(a, std::pow(a.v, p), p * std::pow(a.v, p - 1), p * (p - 1) * std::pow(a.v, p - 2));
+}
+
+/*
+ * Definimos los operadores como funciones `friend` dentro de la clase: así no son
+ * plantillas y el compilador puede convertir un `double` en un `DualVector<N>`, con lo
+ * que expresiones como `1 - x` o `2 * x` funcionan igual que con `Dual`.
+ */
+template <int N>
+struct DualVector {
+    double v, d[N];
+    DualVector(double valor = 0) : v(valor) {
+        for (int i = 0; i < N; i++)
+            d[i] = 0;
+    }
+
+    friend DualVector operator+(DualVector const& a, DualVector const& b) {
+        DualVector r(a.v + b.v);
+        for (int i = 0; i < N; i++)
+            r.d[i] = a.d[i] + b.d[i];
+        return r;
+    }
+
+    friend DualVector operator-(DualVector const& a, DualVector const& b) {
+        DualVector r(a.v - b.v);
+        for (int i = 0; i < N; i++)
+            r.d[i] = a.d[i] - b.d[i];
+        return r;
+    }
+
+    friend DualVector operator-(DualVector const& a) {
+        return aplica(a, -a.v, -1);
+    }
+
+    friend DualVector operator*(DualVector const& a, DualVector const& b) {
+        DualVector r(a.v * b.v);
+        for (int i = 0; i < N; i++)
+            r.d[i] = a.d[i] * b.v + a.v * b.d[i];
+        return r;
+    }
+
+    friend DualVector operator/(DualVector const& a, DualVector const& b) {
+        DualVector r(a.v / b.v);
+        double inv = 1 / (b.v * b.v);
+        for (int i = 0; i < N; i++)
+            r.d[i] = (a.d[i] * b.v - a.v * b.d[i]) * inv;
+        return r;
+    }
+
+    // Igual que `aplica()` para los hiperduales: `g(a + b e) = g(a) + g'(a) b e` en cada una de las `N` partes `e`.
+    friend DualVector aplica(DualVector const& a, double g, double g1) {
+        DualVector r(g);
+        for (int i = 0; i < N; i++)
+            r.d[i] = g1 * a.d[i];
+        return r;
+    }
+};
+
+template <int N> inline DualVector<N> exp(DualVector<N> const& a) { double e = std::exp(a.v); return aplica(a, e, e); }
+template <int N> inline DualVector<N> log(DualVector<N> const& a) { return aplica(a, std::log(a.v), 1 / a.v); }
+template <int N> inline DualVector<N> sin(DualVector<N> const& a) { return aplica(a, std::sin(a.v), std::cos(a.v)); }
+template <int N> inline DualVector<N> cos(DualVector<N> const& a) { return aplica(a, std::cos(a.v), -std::sin(a.v)); }
+template <int N> inline DualVector<N> sqrt(DualVector<N> const& a) { double s = std::sqrt(a.v); return aplica(a, s, 1 / (2 * s)); }
+template <int N> inline DualVector<N> pow(DualVector<N> const& a, double p) {
+    return aplica(a, std::pow(a.v, p), p * std::pow(a.v, p - 1));
+}
+
+// `f'(x)` evaluando `f` una sola vez sobre `x + 1 e`.
+template <typename F>
+double derivadaAutomatica(F f, double x) {
+    return f(Dual(x, 1)).d;
+}
+
+// `f''(x)`: la parte `e1 e2` de `f(x + e1 + e2)`.
+template <typename F>
+double segundaDerivadaAutomatica(F f, double x) {
+    return f(HiperDual(x, 1, 1, 0)).d12;
+}
+
+/*
+ * Derivadas direccionales de `f(const DualVector<N>* x)` en el punto `x` (de `n`
+ * componentes) a lo largo de las `N` direcciones `direcciones[k * n + j]`, todas en una
+ * sola evaluación. Con las `N = n` direcciones de los ejes obtenemos el gradiente.
+ */
+template <int N, typename F>
+void derivadasDireccionales(F f, const double* x, int n, const double* direcciones, double* resultado) {
+    std::vector<DualVector<N> > xd(n);
+    for (int j = 0; j < n; j++) {
+        xd[j] = DualVector<N>(x[j]);
+        for (int k = 0; k < N; k++)
+            xd[j].d[k] = direcciones[k * n + j];
+    }
+    DualVector<N> y = f(xd.data());
+    for (int k = 0; k < N; k++)
+        resultado[k] = y.d[k];
+}
@@ -1,17 +1,120 @@
 #include <iostream>
+#include <iomanip>
 #include <cmath>
+#include <chrono>
 
 #include "derivada.cpp"
+#include "diferenciacion.cpp"
+#include "dual.cpp"
 
 #define X 2.5
 #define MODE 0
 #define EPSILON 0.0001
+#define N_MEDIDA 1000000
+#define DIM_DIRECCIONES 8
 
-double f(double x) {
+// Escrita como plantilla sirve tanto con `double` como con los duales de `dual.cpp`.
+template <typename T>
+T f(T x) {
     return x * exp(-x);
 }
 
+// Función de Rosenbrock: su gradiente es (-2 (1 - x) - 400 x (y - x^2), 200 (y - x^2)).
+double rosenbrock(const double* x) {
+    return (1 - x[0]) * (1 - x[0]) + 100 * (x[1] - x[0] * x[0]) * (x[1] - x[0] * x[0]);
+}
+
+// Paso de coordenadas esféricas (r, theta, phi) a cartesianas.
+void esfericas(const double* x, double* y) {
+    y[0] = x[0] * sin(x[1]) * cos(x[2]);
+    y[1] = x[0] * sin(x[1]) * sin(x[2]);
+    y[2] = x[0] * cos(x[1]);
+}
+
+// Una función de `DIM_DIRECCIONES` variables para calcular varias derivadas direccionales a la vez.
+template <typename T>
+T cadena(const T* x) {
+    T suma = 0;
+    for (int j = 0; j + 1 < DIM_DIRECCIONES; j++)
+        suma = suma + sin(x[j]) * x[j + 1];
+    return suma;
+}
+
+// Ejecuta `calcula(x)` para `N_MEDIDA` valores de `x` y devuelve el tiempo por llamada en ns.
+template <typename C>
+double mide(C calcula) {
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    double suma = 0;
+    for (int i = 0; i < N_MEDIDA; i++)
+        suma += calcula(1 + i * (1.0 / N_MEDIDA));
+    volatile double resultado = suma;
+    (void) resultado;
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() / N_MEDIDA;
+}
+
 int main() {
     std::cout << "Derivada de f(x) para x = " << X << ": " << derivada(f, X, MODE, EPSILON) << std::endl;
+
+    // Con una lambda podemos «capturar» parámetros: aquí derivamos x * exp(-k * x) con k = 2.
+    double k = 2;
+    std::cout << "Derivada de x * exp(-" << k << " * x) para x = " << X << ": "
+              << derivada([k](double x) { return x * exp(-k * x); }, X, MODE, EPSILON) << std::endl;
+    std::cout << "Derivada de sin(x) para x = 0: " << derivada(sin, 0, MODE, EPSILON) << std::endl;
+
+    // La derivada de x * exp(-x) es (1 - x) * exp(-x).
+    double exacta = (1 - X) * exp(-X);
+    std::cout << std::endl << "Error de derivada() con h = " << EPSILON << ":" << std::setprecision(3) << std::endl;
+    for (int mode = 0; mode < 4; mode++)
+        std::cout << "\tmode " << mode << ": " << fabs(derivada(f, X, mode, EPSILON) - exacta) << std::endl;
+    ResultadoDerivada r = derivadaRidders(f, X);
+    std::cout << "\tridders: " << fabs(r.valor - exacta) << " (error estimado = " << r.error << ", "
+              << r.evaluaciones << " evaluaciones)" << std::endl;
+
+    double p[2] = {-1.2, 1}, grad[2];
+    long evaluaciones = gradiente(rosenbrock, p, 2, grad);
+    double exactaX = -2 * (1 - p[0]) - 400 * p[0] * (p[1] - p[0] * p[0]), exactaY = 200 * (p[1] - p[0] * p[0]);
+    std::cout << std::endl << "Gradiente de Rosenbrock en (" << p[0] << ", " << p[1] << "): (" << std::setprecision(15)
+              << grad[0] << ", " << grad[1] << std::setprecision(3) << "), errores = (" << fabs(grad[0] - exactaX) << ", "
+              << fabs(grad[1] - exactaY) << "), " << evaluaciones << " evaluaciones" << std::endl;
+
+    double q[3] = {2, 0.7, 1.1}, jac[9];
+    evaluaciones = jacobiana(esfericas, q, 3, 3, jac);
+    // El determinante de la jacobiana de las coordenadas esféricas es r^2 sin(theta).
+    double det = jac[0] * (jac[4] * jac[8] - jac[5] * jac[7]) - jac[1] * (jac[3] * jac[8] - jac[5] * jac[6])
+               + jac[2] * (jac[3] * jac[7] - jac[4] * jac[6]);
+    std::cout << "Determinante de la jacobiana de las coordenadas esféricas: error = "
+              << fabs(det - q[0] * q[0] * sin(q[1])) << ", " << evaluaciones << " evaluaciones" << std::endl;
+
+    std::cout << std::endl << "Diferenciación automática de f(x) para x = " << X << ":" << std::endl;
+    std::cout << "\tf'(x): error = " << fabs(derivadaAutomatica(f<Dual>, X) - exacta) << std::endl;
+    // f''(x) = (x - 2) * exp(-x).
+    std::cout << "\tf''(x): error = " << fabs(segundaDerivadaAutomatica(f<HiperDual>, X) - (X - 2) * exp(-X)) << std::endl;
+
+    std::cout << std::endl << "Tiempo por derivada (ns):" << std::endl;
+    for (int mode = 0; mode < 4; mode++)
+        std::cout << "\tmode " << mode << ": " << mide([mode](double x) { return derivada(f<double>, x, mode, EPSILON); })
+                  << std::endl;
+    std::cout << "\tridders: " << mide([](double x) { return derivadaRidders(f<double>, x).valor; }) << std::endl;
+    std::cout << "\tdual: " << mide([](double x) { return derivadaAutomatica(f<Dual>, x); }) << std::endl;
+
+    // `DIM_DIRECCIONES` derivadas direccionales: una evaluación con `DualVector` frente a una por dirección con `Dual`.
+    double direcciones[DIM_DIRECCIONES * DIM_DIRECCIONES], punto[DIM_DIRECCIONES], resultado[DIM_DIRECCIONES];
+    for (int i = 0; i < DIM_DIRECCIONES * DIM_DIRECCIONES; i++)
+        direcciones[i] = sin(i + 1.0);
+    std::cout << "\t" << DIM_DIRECCIONES << " derivadas direccionales: DualVector = " << mide([&](double x) {
+        for (int j = 0; j < DIM_DIRECCIONES; j++)
+            punto[j] = x + j;
+        derivadasDireccionales<DIM_DIRECCIONES>(cadena<DualVector<DIM_DIRECCIONES> >, punto, DIM_DIRECCIONES,
+                                                direcciones, resultado);
+        return resultado[0];
+    }) << "; Dual = " << mide([&](double x) {
+        Dual xd[DIM_DIRECCIONES];
+        for (int k = 0; k < DIM_DIRECCIONES; k++) {
+            for (int j = 0; j < DIM_DIRECCIONES; j++)
+                xd[j] = Dual(x + j, direcciones[k * DIM_DIRECCIONES + j]);
+            resultado[k] = cadena(xd).d;
+        }
+        return resultado[0];
+    }) << std::endl;
     return 0;
 }
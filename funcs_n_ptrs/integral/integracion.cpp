@@ -0,0 +1,238 @@
+/*
+ * Motor de integración numérica que va más allá de la suma de Riemann de `integral.cpp`:
+ *  - Reglas compuestas del trapecio, de Simpson y de Gauss-Legendre (7 puntos) sobre
+ *    `n` subintervalos. Los puntos se calculan a partir de un índice entero, con lo
+ *    que siempre se hacen exactamente las mismas evaluaciones.
+ *  - Integración adaptativa: dividimos en dos el subintervalo con mayor error estimado
+ *    hasta que la suma de los errores queda por debajo de la tolerancia. Así los puntos
+ *    se concentran donde la función es «difícil» y no se desperdician donde es suave.
+ *  - Un modo multihilo que reparte `[a, b]` entre los núcleos disponibles.
+ * Como `integral()`, todas las funciones aceptan cualquier objeto invocable (punteros,
+ * lambdas, functores...) para que el compilador pueda integrar el integrando en los bucles.
+ */
+
+#include <cmath>
+#include <queue>
+#include <thread>
+#include <vector>
+
+enum ReglaIntegracion {TRAPECIO, SIMPSON, GAUSS_LEGENDRE};
+
+/*
+ * El valor, el error estimado y las evaluaciones de `f`. `convergido` es `false` si
+ * hemos parado por agotar el presupuesto (subintervalos o puntos) antes de que el
+ * error estimado bajara de la tolerancia pedida.
+ */
+struct ResultadoIntegral {
+    double valor, error;
+    long evaluaciones;
+    bool convergido;
+};
+
+const char* nombreRegla(ReglaIntegracion regla) {
+    switch (regla) {
+        case TRAPECIO:
+            return "trapecio";
+        case SIMPSON:
+            return "simpson";
+        default:
+            return "gauss-legendre";
+    }
+}
+
+/*
+ * Nodos y pesos de la pareja de Gauss-Kronrod 7-15 en [-1, 1] (los mismos que usa
+ * QUADPACK). Los nodos impares (`NODOS_K15[1]`, `[3]`, `[5]` y `[7]`) son los de
+ * Gauss-Legendre de 7 puntos, con lo que la regla de 15 puntos reaprovecha sus
+ * evaluaciones y la diferencia entre ambas nos da una estimación del error.
+ * Más información -> https://en.wikipedia.org/wiki/Gauss%E2%80%93Kronrod_quadrature_formula
+ */
+const double NODOS_K15[8] = {
+    0.991455371120812639206854697526329, 0.949107912342758524526189684047851,
+    0.864864423359769072789712788640926, 0.741531185599394439863864773280788,
+    0.586087235467691130294144845693013, 0.405845151377397166906606412076961,
+    0.207784955007898467600689403773245, 0.000000000000000000000000000000000
+};
+const double PESOS_K15[8] = {
+    0.022935322010529224963732008058970, 0.063092092629978553290700663189204,
+    0.104790010322250183839876322541518, 0.140653259715525918745189590510238,
+    0.169004726639267902826583426598550, 0.190350578064785409913256402421014,
+    0.204432940075298892414161999234649, 0.209482141084727828012999174891714
+};
+const double PESOS_G7[4] = {
+    0.129484966168869693270611432679082, 0.279705391489276667901467771423780,
+    0.381830050505118944950369775488975, 0.417959183673469387755102040816327
+};
+
+template <typename F>
+double trapecio(F f, double a, double b, long n) {
+    double h = (b - a) / n, suma = (f(a) + f(b)) / 2;
+    for (long i = 1; i < n; i++)
+        suma += f(a + i * h);
+    return h * suma;
+}
+
+// Simpson necesita un número par de subintervalos: si `n` es impar usamos `n + 1`.
+template <typename F>
+double simpson(F f, double a, double b, long n) {
+    n += n % 2;
+    double h = (b - a) / n, pares = 0, impares = 0;
+    for (long i = 1; i < n; i += 2)
+        impares += f(a + i * h);
+    for (long i = 2; i < n; i += 2)
+        pares += f(a + i * h);
+    return h / 3 * (f(a) + 4 * impares + 2 * pares + f(b));
+}
+
+// Gauss-Legendre de 7 puntos en cada uno de los `n` subintervalos.
+template <typename F>
+double gaussLegendre(F f, double a, double b, long n) {
+    double h = (b - a) / n, suma = 0;
+    for (long i = 0; i < n; i++) {
+        double centro = a + (i + 0.5) * h, radio = h / 2, parcial = PESOS_G7[3] * f(centro);
+        for (int k = 0; k < 3; k++) {
+            double dx = radio * NODOS_K15[2 * k + 1];
+            parcial += PESOS_G7[k] * (f(centro - dx) + f(centro + dx));
+        }
+        suma += radio * parcial;
+    }
+    return suma;
+}
+
+template <typename F>
+double integraCompuesta(F f, double a, double b, long n, ReglaIntegracion regla) {
+    switch (regla) {
+        case TRAPECIO:
+            return trapecio(f, a, b, n);
+        case SIMPSON:
+            return simpson(f, a, b, n);
+        default:
+            return gaussLegendre(f, a, b, n);
+    }
+}
+
+struct Intervalo {
+    double a, b, valor, error;
+};
+
+// Para que `std::priority_queue` nos dé siempre el intervalo con mayor error.
+bool operator<(Intervalo const& x, Intervalo const& y) {
+    return x.error < y.error;
+}
+
+/*
+ * Integra `f` en `[a, b]` con la regla indicada y estima el error comparándola con
+ * una versión más precisa de sí misma:
+ *  - Trapecio y Simpson: la regla con uno y con dos subintervalos. Como su error es
+ *    proporcional a `h^2` y `h^4`, la diferencia entre ambas es 3 y 15 veces el error
+ *    de la más fina.
+ *  - Gauss-Legendre: la diferencia entre Gauss de 7 puntos y Kronrod de 15 puntos.
+ * Devolvemos siempre el valor más preciso de los dos.
+ */
+template <typename F>
+Intervalo estimaIntervalo(F f, double a, double b, ReglaIntegracion regla, long& evaluaciones) {
+    Intervalo r = {a, b, 0, 0};
+    double m = (a + b) / 2, h = b - a;
+
+    if (regla == TRAPECIO) {
+        double fa = f(a), fm = f(m), fb = f(b);
+        double grueso = h * (fa + fb) / 2, fino = h * (fa + 2 * fm + fb) / 4;
+        r.valor = fino;
+        r.error = std::fabs(fino - grueso) / 3;
+        evaluaciones += 3;
+    } else if (regla == SIMPSON) {
+        double fa = f(a), f1 = f(a + h / 4), fm = f(m), f3 = f(a + 3 * h / 4), fb = f(b);
+        double grueso = h * (fa + 4 * fm + fb) / 6, fino = h * (fa + 4 * f1 + 2 * fm + 4 * f3 + fb) / 12;
+        r.valor = fino;
+        r.error = std::fabs(fino - grueso) / 15;
+        evaluaciones += 5;
+    } else {
+        double radio = h / 2, fc = f(m);
+        double gauss = PESOS_G7[3] * fc, kronrod = PESOS_K15[7] * fc;
+        for (int k = 0; k < 7; k++) {
+            double dx = radio * NODOS_K15[k], suma = f(m - dx) + f(m + dx);
+            kronrod += PESOS_K15[k] * suma;
+            if (k % 2 == 1)
+                gauss += PESOS_G7[k / 2] * suma;
+        }
+        r.valor = radio * kronrod;
+        r.error = radio * std::fabs(kronrod - gauss);
+        evaluaciones += 15;
+    }
+
+    return r;
+}
+
+// Número máximo de subintervalos de la integración adaptativa.
+#define MAX_INTERVALOS 100000
+
+/*
+ * Integración adaptativa «global»: guardamos los subintervalos en una cola de
+ * prioridad ordenada por su error y dividimos siempre el peor hasta que la suma de
+ * los errores sea menor que `tolerancia` (o lleguemos a `MAX_INTERVALOS`, en cuyo caso
+ * el resultado lleva `convergido = false` y el error que sí hemos alcanzado).
+ */
+template <typename F>
+ResultadoIntegral integralAdaptativa(F f, double a, double b, double tolerancia,
+                                     ReglaIntegracion regla = GAUSS_LEGENDRE) {
+    ResultadoIntegral r = {0, 0, 0, false};
+    std::priority_queue<Intervalo> cola;
+
+    Intervalo inicial = estimaIntervalo(f, a, b, regla, r.evaluaciones);
+    double error = inicial.error;
+    cola.push(inicial);
+
+    while (error > tolerancia && cola.size() < MAX_INTERVALOS) {
+        Intervalo peor = cola.top();
+        cola.pop();
+        double m = (peor.a + peor.b) / 2;
+        Intervalo izq = estimaIntervalo(f, peor.a, m, regla, r.evaluaciones);
+        Intervalo der = estimaIntervalo(f, m, peor.b, regla, r.evaluaciones);
+        error += izq.error + der.error - peor.error;
+        cola.push(izq);
+        cola.push(der);
+    }
+
+    // Recalculamos los totales desde cero para no arrastrar los redondeos de las actualizaciones.
+    while (!cola.empty()) {
+        r.valor += cola.top().valor;
+        r.error += cola.top().error;
+        cola.pop();
+    }
+    r.convergido = r.error <= tolerancia;
+    return r;
+}
+
+/*
+ * Reparte `[a, b]` en `hilos` trozos iguales (`0` usa todos los núcleos) e integra cada
+ * uno de forma adaptativa en su propio hilo con una parte proporcional de la tolerancia.
+ * Para compilar hay que pasar `-pthread` a `g++`.
+ */
+template <typename F>
+ResultadoIntegral integralParalela(F f, double a, double b, double tolerancia,
+                                   ReglaIntegracion regla = GAUSS_LEGENDRE, unsigned hilos = 0) {
+    if (hilos == 0)
+        hilos = std::thread::hardware_concurrency();
+    if (hilos == 0)
+        hilos = 1;
+
+    std::vector<ResultadoIntegral> parciales(hilos);
+    std::vector<std::thread> trabajadores;
+    double h = (b - a) / hilos;
+    for (unsigned t = 0; t < hilos; t++) {
+        double ini = a + t * h, fin = t + 1 == hilos ? b : a + (t + 1) * h;
+        trabajadores.push_back(std::thread([=, &parciales]() {
+            parciales[t] = integralAdaptativa(f, ini, fin, tolerancia / hilos, regla);
+        }));
+    }
+
+    ResultadoIntegral r = {0, 0, 0, true};
+    for (unsigned t = 0; t < hilos; t++) {
+        trabajadores[t].join();
+        r.valor += parciales[t].valor;
+        r.error += parciales[t].error;
+        r.evaluaciones += parciales[t].evaluaciones;
+        r.convergido = r.convergido && parciales[t].convergido;
+    }
+    return r;
+}
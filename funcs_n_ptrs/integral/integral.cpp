@@ -1,8 +1,32 @@
+/*
+ * Versión para cualquier objeto «invocable»: lambdas, functores o `std::function`.
+ * El compilador genera una versión para cada tipo `F` y, salvo con `std::function`
+ * (que por dentro es otra llamada indirecta), ve el cuerpo del integrando y lo puede
+ * integrar en el bucle. Con un puntero, en cambio, cada evaluación es una llamada a
+ * una dirección que solo se conoce al ejecutar. Si pasamos el nombre de una función
+ * se usa la sobrecarga de abajo, ya que ante un empate se prefiere la que no es una
+ * plantilla.
+ *
+ * Como la suma en coma flotante no es asociativa el compilador no puede reordenarla
+ * para vectorizarla: le damos 8 acumuladores independientes para que pueda sumar
+ * varios términos a la vez. Por eso el resultado puede diferir en los últimos bits.
+ */
+template <typename F>
+double integral(F f, double a, double b, int n) {
+    double s[8] = {0, 0, 0, 0, 0, 0, 0, 0}, delta = (b - a) / double(n);
+    int i = 0;
+    for (; i + 8 <= n; i += 8)
+        for (int k = 0; k < 8; k++)
+            s[k] += f(a + (i + k) * delta);
+    for (; i < n; i++)
+        s[0] += f(a + i * delta);
+    return delta * (((s[0] + s[1]) + (s[2] + s[3])) + ((s[4] + s[5]) + (s[6] + s[7])));
+}
+
+/*
+ * Sobrecarga para punteros a función. Reutiliza el bucle de la plantilla para que la
+ * única diferencia con una lambda sea la llamada indirecta y las medidas sean justas.
+ */
 double integral(double f(double), double a, double b, int n) {
-    double suma = 0, delta = (b - a) / double(n);
-    for (double i = a; i <= b; i += delta) {
-        suma += f(i);
-        // std::cout << suma << std::endl;
-    }
-    return delta * suma;
+    return integral<double (*)(double)>(f, a, b, n);
 }
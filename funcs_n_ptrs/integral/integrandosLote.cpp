@@ -0,0 +1,291 @@
+/*
+ * Integrandos «por lotes»: en vez de evaluar `f(x)` punto a punto, cada llamada
+ * recibe un array de abscisas y rellena otro con los valores, i.e.
+ *      void f(const double* x, double* y, long n)
+ * Así pagamos una única llamada por lote y, sobre todo, podemos calcular varios
+ * puntos a la vez con instrucciones vectoriales: `std::exp()` y `std::sin()` solo
+ * trabajan con un `double`, con lo que aquí incluimos versiones AVX-512 (8 `double`s)
+ * y AVX2 (4 `double`s) propias. Si el procesador no las soporta usamos `<cmath>`.
+ *
+ * Las reglas `*PorLotes()` generan los puntos en bloques de `BLOQUE_LOTE` (8 KiB de
+ * abscisas, 8 KiB de valores y 8 KiB de pesos, que caben en la caché L1) y se los
+ * pasan al integrando. Usan las constantes de `integracion.cpp`, que hay que incluir antes.
+ */
+
+#include <cmath>
+
+#if defined(__AVX512F__) || (defined(__AVX2__) && defined(__FMA__))
+#include <immintrin.h>
+#endif
+
+#define BLOQUE_LOTE 1024
+
+const char* integrandosSimdNombre() {
+#if defined(__AVX512F__)
+    return "AVX-512";
+#elif defined(__AVX2__) && defined(__FMA__)
+    return "AVX2";
+#else
+    return "ninguno (escalar)";
+#endif
+}
+
+/*
+ * Para `exp(x)` escribimos `x = k * ln(2) + r` con `k` entero y `|r| <= ln(2) / 2`,
+ * con lo que `exp(x) = 2^k * exp(r)`. `ln(2)` se resta en dos partes (la segunda es
+ * lo que le falta a la primera para ser exacta) para no perder precisión en `r`, y
+ * `exp(r)` se aproxima con su serie de Taylor hasta `r^13`, cuyo error es menor que
+ * el redondeo de un `double`. Solo es válido para `x` en `[-708, 709]`: fuera de ese
+ * intervalo `exp(x)` no es representable como un `double` normalizado.
+ *
+ * Para `sin(x)` escribimos `x = k * pi + r` con `|r| <= pi / 2`, de modo que
+ * `sin(x) = (-1)^k sin(r)`, y aproximamos `sin(r)` con su serie hasta `r^21`. La
+ * reducción pierde precisión para `|x|` muy grandes (del orden de `1e8` o más).
+ *
+ * Para redondear usamos el truco de sumar `REDONDEO = 1.5 * 2^52`: a partir de `2^52`
+ * los `double` consecutivos distan 1, con lo que la suma redondea `y` al entero más
+ * cercano y este queda escrito en los bits bajos de la mantisa. Restando `REDONDEO`
+ * recuperamos `k` como `double`, y restando sus bits obtenemos `k` como entero
+ * (`2^k` y la paridad de `k` salen de ahí sin convertir nada).
+ */
+#define EXP_MIN -708.0
+#define EXP_MAX 709.0
+#define LN2_A 0.6931471805599453
+#define LN2_B 2.3190468138462996e-17
+#define PI_A 3.141592653589793
+#define PI_B 1.2246467991473532e-16
+#define REDONDEO 6755399441055744.0
+
+// 1 / i! para i = 13, 12, ..., 0 (Horner empieza por el término de mayor grado).
+const double COEF_EXP[14] = {
+    1.0 / 6227020800, 1.0 / 479001600, 1.0 / 39916800, 1.0 / 3628800, 1.0 / 362880, 1.0 / 40320,
+    1.0 / 5040, 1.0 / 720, 1.0 / 120, 1.0 / 24, 1.0 / 6, 1.0 / 2, 1, 1
+};
+
+// (-1)^i / (2i + 1)! para i = 10, 9, ..., 0, i.e. los coeficientes de `r^21`, `r^19`, ..., `r`.
+const double COEF_SIN[11] = {
+    1.0 / 51090942171709440000.0, -1.0 / 121645100408832000.0, 1.0 / 355687428096000.0,
+    -1.0 / 1307674368000.0, 1.0 / 6227020800, -1.0 / 39916800, 1.0 / 362880, -1.0 / 5040,
+    1.0 / 120, -1.0 / 6, 1
+};
+
+/*
+ * GCC 12 avisa de un `-Wmaybe-uninitialized` falso dentro de sus propias cabeceras de
+ * AVX-512 (las intrínsecas rellenan un vector «indefinido» que luego no usan). Lo
+ * silenciamos solo en esta parte del fichero.
+ */
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+#if defined(__AVX512F__)
+inline __m512d expVector(__m512d x) {
+    x = _mm512_min_pd(_mm512_max_pd(x, _mm512_set1_pd(EXP_MIN)), _mm512_set1_pd(EXP_MAX));
+    __m512d kr = _mm512_fmadd_pd(x, _mm512_set1_pd(1 / LN2_A), _mm512_set1_pd(REDONDEO));
+    __m512d k = _mm512_sub_pd(kr, _mm512_set1_pd(REDONDEO));
+    __m512d r = _mm512_fnmadd_pd(k, _mm512_set1_pd(LN2_A), x);
+    r = _mm512_fnmadd_pd(k, _mm512_set1_pd(LN2_B), r);
+
+    __m512d p = _mm512_set1_pd(COEF_EXP[0]);
+    for (int i = 1; i < 14; i++)
+        p = _mm512_fmadd_pd(p, r, _mm512_set1_pd(COEF_EXP[i]));
+
+    // Construimos `2^k` escribiendo `k + 1023` en los bits del exponente de un `double`.
+    __m512i e = _mm512_sub_epi64(_mm512_castpd_si512(kr), _mm512_castpd_si512(_mm512_set1_pd(REDONDEO)));
+    e = _mm512_slli_epi64(_mm512_add_epi64(e, _mm512_set1_epi64(1023)), 52);
+    return _mm512_mul_pd(p, _mm512_castsi512_pd(e));
+}
+
+inline __m512d sinVector(__m512d x) {
+    __m512d kr = _mm512_fmadd_pd(x, _mm512_set1_pd(1 / PI_A), _mm512_set1_pd(REDONDEO));
+    __m512d k = _mm512_sub_pd(kr, _mm512_set1_pd(REDONDEO));
+    __m512d r = _mm512_fnmadd_pd(k, _mm512_set1_pd(PI_A), x);
+    r = _mm512_fnmadd_pd(k, _mm512_set1_pd(PI_B), r);
+
+    __m512d r2 = _mm512_mul_pd(r, r), p = _mm512_set1_pd(COEF_SIN[0]);
+    for (int i = 1; i < 11; i++)
+        p = _mm512_fmadd_pd(p, r2, _mm512_set1_pd(COEF_SIN[i]));
+    p = _mm512_mul_pd(p, r);
+
+    // El último bit de la mantisa de `kr` es la paridad de `k`: si es impar cambiamos el bit de signo.
+    __m512i signo = _mm512_slli_epi64(_mm512_and_si512(_mm512_castpd_si512(kr), _mm512_set1_epi64(1)), 63);
+    return _mm512_castsi512_pd(_mm512_xor_si512(_mm512_castpd_si512(p), signo));
+}
+#elif defined(__AVX2__) && defined(__FMA__)
+inline __m256d expVector(__m256d x) {
+    x = _mm256_min_pd(_mm256_max_pd(x, _mm256_set1_pd(EXP_MIN)), _mm256_set1_pd(EXP_MAX));
+    __m256d kr = _mm256_fmadd_pd(x, _mm256_set1_pd(1 / LN2_A), _mm256_set1_pd(REDONDEO));
+    __m256d k = _mm256_sub_pd(kr, _mm256_set1_pd(REDONDEO));
+    __m256d r = _mm256_fnmadd_pd(k, _mm256_set1_pd(LN2_A), x);
+    r = _mm256_fnmadd_pd(k, _mm256_set1_pd(LN2_B), r);
+
+    __m256d p = _mm256_set1_pd(COEF_EXP[0]);
+    for (int i = 1; i < 14; i++)
+        p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(COEF_EXP[i]));
+
+    __m256i e = _mm256_sub_epi64(_mm256_castpd_si256(kr), _mm256_castpd_si256(_mm256_set1_pd(REDONDEO)));
+    e = _mm256_slli_epi64(_mm256_add_epi64(e, _mm256_set1_epi64x(1023)), 52);
+    return _mm256_mul_pd(p, _mm256_castsi256_pd(e));
+}
+
+inline __m256d sinVector(__m256d x) {
+    __m256d kr = _mm256_fmadd_pd(x, _mm256_set1_pd(1 / PI_A), _mm256_set1_pd(REDONDEO));
+    __m256d k = _mm256_sub_pd(kr, _mm256_set1_pd(REDONDEO));
+    __m256d r = _mm256_fnmadd_pd(k, _mm256_set1_pd(PI_A), x);
+    r = _mm256_fnmadd_pd(k, _mm256_set1_pd(PI_B), r);
+
+    __m256d r2 = _mm256_mul_pd(r, r), p = _mm256_set1_pd(COEF_SIN[0]);
+    for (int i = 1; i < 11; i++)
+        p = _mm256_fmadd_pd(p, r2, _mm256_set1_pd(COEF_SIN[i]));
+    p = _mm256_mul_pd(p, r);
+
+    __m256i signo = _mm256_slli_epi64(_mm256_and_si256(_mm256_castpd_si256(kr), _mm256_set1_epi64x(1)), 63);
+    return _mm256_castsi256_pd(_mm256_xor_si256(_mm256_castpd_si256(p), signo));
+}
+#endif
+
+/*
+ * Los integrandos por lotes. Los elementos que no completan un vector se calculan
+ * con las funciones de `<cmath>`.
+ */
+void expLote(const double* x, double* y, long n) {
+    long i = 0;
+#if defined(__AVX512F__)
+    for (; i + 8 <= n; i += 8)
+        _mm512_storeu_pd(y + i, expVector(_mm512_loadu_pd(x + i)));
+#elif defined(__AVX2__) && defined(__FMA__)
+    for (; i + 4 <= n; i += 4)
+        _mm256_storeu_pd(y + i, expVector(_mm256_loadu_pd(x + i)));
+#endif
+    for (; i < n; i++)
+        y[i] = std::exp(x[i]);
+}
+
+void sinLote(const double* x, double* y, long n) {
+    long i = 0;
+#if defined(__AVX512F__)
+    for (; i + 8 <= n; i += 8)
+        _mm512_storeu_pd(y + i, sinVector(_mm512_loadu_pd(x + i)));
+#elif defined(__AVX2__) && defined(__FMA__)
+    for (; i + 4 <= n; i += 4)
+        _mm256_storeu_pd(y + i, sinVector(_mm256_loadu_pd(x + i)));
+#endif
+    for (; i < n; i++)
+        y[i] = std::sin(x[i]);
+}
+
+// x * exp(-x), la `f(x)` de `testIntegral.cpp`.
+void xExpLote(const double* x, double* y, long n) {
+    long i = 0;
+#if defined(__AVX512F__)
+    for (; i + 8 <= n; i += 8) {
+        __m512d v = _mm512_loadu_pd(x + i);
+        _mm512_storeu_pd(y + i, _mm512_mul_pd(v, expVector(_mm512_sub_pd(_mm512_setzero_pd(), v))));
+    }
+#elif defined(__AVX2__) && defined(__FMA__)
+    for (; i + 4 <= n; i += 4) {
+        __m256d v = _mm256_loadu_pd(x + i);
+        _mm256_storeu_pd(y + i, _mm256_mul_pd(v, expVector(_mm256_sub_pd(_mm256_setzero_pd(), v))));
+    }
+#endif
+    for (; i < n; i++)
+        y[i] = x[i] * std::exp(-x[i]);
+}
+
+#pragma GCC diagnostic pop
+
+// x, la `g(x)` de `testIntegral.cpp`. Un bucle tan sencillo lo vectoriza el propio compilador.
+void identidadLote(const double* x, double* y, long n) {
+    for (long i = 0; i < n; i++)
+        y[i] = x[i];
+}
+
+/*
+ * Suma `pesos[i] * y[i]`. Usamos 8 acumuladores independientes, como en la versión
+ * plantilla de `integral()`, para que el compilador pueda vectorizar la suma.
+ */
+inline double sumaPonderada(const double* y, const double* pesos, long n) {
+    double s[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    long i = 0;
+    for (; i + 8 <= n; i += 8)
+        for (int k = 0; k < 8; k++)
+            s[k] += pesos[i + k] * y[i + k];
+    for (; i < n; i++)
+        s[0] += pesos[i] * y[i];
+    return ((s[0] + s[1]) + (s[2] + s[3])) + ((s[4] + s[5]) + (s[6] + s[7]));
+}
+
+/*
+ * Evalúa `f` en los puntos `a + i * h` para `i` en `[0, n]` por bloques y devuelve
+ * la suma ponderada con los pesos `patron[i % P]`. Repetimos el patrón una sola vez
+ * a lo largo de todo un bloque: como `BLOQUE_LOTE` es múltiplo de `P` (1 o 2 en
+ * nuestro caso) sirve igual para todos los bloques y la suma no necesita calcular
+ * ningún `%`.
+ */
+template <typename F>
+double sumaPuntosLote(F f, double a, double h, long n, const double* patron, long P) {
+    double x[BLOQUE_LOTE], y[BLOQUE_LOTE], pesos[BLOQUE_LOTE], suma = 0;
+    for (long k = 0; k < BLOQUE_LOTE; k++)
+        pesos[k] = patron[k % P];
+    for (long i0 = 0; i0 <= n; i0 += BLOQUE_LOTE) {
+        long m = n + 1 - i0 < BLOQUE_LOTE ? n + 1 - i0 : BLOQUE_LOTE;
+        for (long k = 0; k < m; k++)
+            x[k] = a + (i0 + k) * h;
+        f(x, y, m);
+        suma += sumaPonderada(y, pesos, m);
+    }
+    return suma;
+}
+
+template <typename F>
+double trapecioPorLotes(F f, double a, double b, long n) {
+    const double pesos[1] = {1};
+    double h = (b - a) / n, extremos[2] = {a, b}, fExtremos[2];
+    f(extremos, fExtremos, 2);
+    // Todos los puntos pesan 1 salvo los extremos, que pesan 1/2.
+    return h * (sumaPuntosLote(f, a, h, n, pesos, 1) - (fExtremos[0] + fExtremos[1]) / 2);
+}
+
+template <typename F>
+double simpsonPorLotes(F f, double a, double b, long n) {
+    n += n % 2;
+    const double pesos[2] = {2, 4};
+    double h = (b - a) / n, extremos[2] = {a, b}, fExtremos[2];
+    f(extremos, fExtremos, 2);
+    // Los pesos son 1, 4, 2, 4, ..., 2, 4, 1: sumamos con 2 y 4 y corregimos los extremos.
+    return h / 3 * (sumaPuntosLote(f, a, h, n, pesos, 2) - fExtremos[0] - fExtremos[1]);
+}
+
+// Gauss-Legendre de 7 puntos (ver `integracion.cpp`): metemos en cada bloque los nodos de varios subintervalos.
+template <typename F>
+double gaussLegendrePorLotes(F f, double a, double b, long n) {
+    const long PANELES = BLOQUE_LOTE / 7;
+    const double NODOS[7] = {-NODOS_K15[1], -NODOS_K15[3], -NODOS_K15[5], 0, NODOS_K15[5], NODOS_K15[3], NODOS_K15[1]};
+    const double PESOS[7] = {PESOS_G7[0], PESOS_G7[1], PESOS_G7[2], PESOS_G7[3], PESOS_G7[2], PESOS_G7[1], PESOS_G7[0]};
+
+    double x[7 * PANELES], y[7 * PANELES], pesos[7 * PANELES], h = (b - a) / n, suma = 0;
+    for (long k = 0; k < 7 * PANELES; k++)
+        pesos[k] = PESOS[k % 7];
+    for (long i0 = 0; i0 < n; i0 += PANELES) {
+        long paneles = n - i0 < PANELES ? n - i0 : PANELES;
+        for (long p = 0; p < paneles; p++) {
+            double centro = a + (i0 + p + 0.5) * h;
+            for (int k = 0; k < 7; k++)
+                x[7 * p + k] = centro + h / 2 * NODOS[k];
+        }
+        f(x, y, 7 * paneles);
+        suma += sumaPonderada(y, pesos, 7 * paneles);
+    }
+    return h / 2 * suma;
+}
+
+template <typename F>
+double integraCompuestaPorLotes(F f, double a, double b, long n, ReglaIntegracion regla) {
+    switch (regla) {
+        case TRAPECIO:
+            return trapecioPorLotes(f, a, b, n);
+        case SIMPSON:
+            return simpsonPorLotes(f, a, b, n);
+        default:
+            return gaussLegendrePorLotes(f, a, b, n);
+    }
+}
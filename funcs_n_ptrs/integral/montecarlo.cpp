@@ -0,0 +1,308 @@
+/*
+ * Integración multidimensional sobre una «caja» `[a[0], b[0]] x ... x [a[d-1], b[d-1]]`.
+ * Con `d` dimensiones una regla compuesta con `n` puntos por eje necesita `n^d`
+ * evaluaciones, con lo que a partir de unas pocas dimensiones es mejor muestrear:
+ *  - Monte Carlo: promediamos `f` en puntos aleatorios. El error decrece como
+ *    `1 / sqrt(N)` sea cual sea la dimensión y lo estimamos con la varianza muestral.
+ *  - Quasi-Monte Carlo: en vez de puntos aleatorios usamos las secuencias de Halton o
+ *    de Sobol, que reparten los puntos de manera mucho más uniforme y convergen casi
+ *    como `1 / N` para integrandos suaves. Para estimar el error desplazamos toda la
+ *    secuencia (módulo 1) con `DESPLAZAMIENTOS_QMC` vectores aleatorios distintos y
+ *    miramos la dispersión entre los resultados, que son muy pocos para fiarnos de
+ *    una sola desviación típica.
+ *  - Muestreo estratificado: dividimos cada eje en `k` trozos y tomamos el mismo número
+ *    de puntos aleatorios en cada una de las `k^d` celdas. Así eliminamos la varianza
+ *    «entre celdas» y nos quedamos solo con la de dentro de cada una.
+ * Todas las funciones siguen muestreando hasta que el error estimado baja de
+ * `tolerancia` o hasta llegar a `maxPuntos` evaluaciones. El integrando es cualquier
+ * objeto invocable como `f(const double* x)`, y el resultado es un `ResultadoIntegral`
+ * de `integracion.cpp`, que hay que incluir antes.
+ */
+
+#include <cmath>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#define MAX_DIM_HALTON 16
+#define MAX_DIM_SOBOL 10
+#define BITS_SOBOL 32
+// Puntos de cada bloque de Monte Carlo y bloques que se calculan antes de mirar el error.
+#define BLOQUE_MC 4096
+#define BLOQUES_RONDA_MC 32
+#define DESPLAZAMIENTOS_QMC 16
+// Cuantil 97.5% de la t de Student con `DESPLAZAMIENTOS_QMC - 1` grados de libertad (intervalo del 95%).
+#define T_STUDENT_QMC 2.131
+#define PUNTOS_INICIALES_QMC 1024
+#define MAX_CELDAS 4096
+
+enum SecuenciaQMC {HALTON, SOBOL};
+
+/*
+ * Generador «basado en contador»: el número aleatorio `i` se obtiene mezclando los bits
+ * de `semilla + i * constante` (es el generador SplitMix64 accedido directamente en la
+ * posición `i`). Al no haber estado que vaya avanzando cada hilo puede calcular justo
+ * los números que necesita, y el punto `k` es siempre el mismo por muchos hilos que
+ * haya: el resultado es reproducible.
+ * Más información -> https://prng.di.unimi.it/splitmix64.c
+ */
+inline uint64_t mezclaBits(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Número uniforme en `[0, 1)` con los 53 bits más altos.
+inline double uniforme(uint64_t semilla, uint64_t contador) {
+    return (mezclaBits(semilla + (contador + 1) * 0x9E3779B97F4A7C15ULL) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+double volumenCaja(int dim, const double* a, const double* b) {
+    double v = 1;
+    for (int j = 0; j < dim; j++)
+        v *= b[j] - a[j];
+    return v;
+}
+
+/*
+ * Media y suma de cuadrados de las desviaciones (`m2`) de un conjunto de muestras.
+ * Dos conjuntos se combinan sin perder precisión con la fórmula de Chan et al.
+ * Más información -> https://en.wikipedia.org/wiki/Algorithms_for_calculating_variance
+ */
+struct Estadistica {
+    double media, m2;
+    long n;
+};
+
+inline void anadeMuestra(Estadistica& e, double y) {
+    e.n++;
+    double delta = y - e.media;
+    e.media += delta / e.n;
+    e.m2 += delta * (y - e.media);
+}
+
+inline void combina(Estadistica& e, Estadistica const& otra) {
+    if (otra.n == 0)
+        return;
+    long n = e.n + otra.n;
+    double delta = otra.media - e.media;
+    e.media += delta * otra.n / n;
+    e.m2 += otra.m2 + delta * delta * ((double) e.n * otra.n / n);
+    e.n = n;
+}
+
+// Evalúa los `BLOQUE_MC` puntos del bloque `bloque`. Las coordenadas del punto `k` usan los contadores `k * dim + j`.
+template <typename F>
+Estadistica bloqueMonteCarlo(F f, int dim, const double* a, const double* b, uint64_t semilla, long bloque) {
+    Estadistica e = {0, 0, 0};
+    std::vector<double> x(dim);
+    for (long k = bloque * BLOQUE_MC; k < (bloque + 1) * BLOQUE_MC; k++) {
+        for (int j = 0; j < dim; j++)
+            x[j] = a[j] + (b[j] - a[j]) * uniforme(semilla, (uint64_t) k * dim + j);
+        anadeMuestra(e, f(x.data()));
+    }
+    return e;
+}
+
+/*
+ * Monte Carlo «puro» repartido entre `hilos` hilos (`0` usa todos los núcleos). Los
+ * puntos se agrupan en bloques de `BLOQUE_MC`; en cada ronda calculamos
+ * `BLOQUES_RONDA_MC` bloques (el hilo `t` se encarga de los bloques `t`, `t + hilos`...)
+ * y los combinamos siempre en el mismo orden. Como además el error se comprueba solo al
+ * acabar cada ronda, el resultado no depende del número de hilos.
+ * Para compilar hay que pasar `-pthread` a `g++`.
+ */
+template <typename F>
+ResultadoIntegral integralMonteCarlo(F f, int dim, const double* a, const double* b, double tolerancia,
+                                     long maxPuntos, unsigned hilos = 0, uint64_t semilla = 2022) {
+    if (hilos == 0)
+        hilos = std::thread::hardware_concurrency();
+    if (hilos == 0)
+        hilos = 1;
+
+    double volumen = volumenCaja(dim, a, b);
+    Estadistica total = {0, 0, 0};
+    std::vector<Estadistica> ronda(BLOQUES_RONDA_MC);
+    ResultadoIntegral r = {0, 0, 0, false};
+
+    for (long primero = 0; r.evaluaciones < maxPuntos; primero += BLOQUES_RONDA_MC) {
+        std::vector<std::thread> trabajadores;
+        for (unsigned t = 0; t < hilos && t < BLOQUES_RONDA_MC; t++)
+            trabajadores.push_back(std::thread([=, &ronda]() {
+                for (unsigned i = t; i < BLOQUES_RONDA_MC; i += hilos)
+                    ronda[i] = bloqueMonteCarlo(f, dim, a, b, semilla, primero + i);
+            }));
+        for (unsigned t = 0; t < trabajadores.size(); t++)
+            trabajadores[t].join();
+
+        for (int i = 0; i < BLOQUES_RONDA_MC; i++)
+            combina(total, ronda[i]);
+        r.evaluaciones = total.n;
+        r.valor = volumen * total.media;
+        r.error = volumen * std::sqrt(total.m2 / (total.n - 1) / total.n);
+        r.convergido = r.error < tolerancia;
+        if (r.convergido)
+            break;
+    }
+    return r;
+}
+
+/*
+ * Inversa radical: escribimos `i` en base `p` y «reflejamos» sus cifras respecto a la
+ * coma, i.e. `i = 6 = 110_2` da `0.011_2 = 0.375`. La coordenada `j` del punto `i` de
+ * Halton es la inversa radical en la base del primo `j`-ésimo.
+ */
+const int PRIMOS_HALTON[MAX_DIM_HALTON] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53};
+
+inline double inversaRadical(uint64_t i, int p) {
+    double x = 0, escala = 1.0 / p;
+    for (; i > 0; i /= p, escala /= p)
+        x += (i % p) * escala;
+    return x;
+}
+
+/*
+ * Números de dirección de Sobol de Joe y Kuo (fichero `new-joe-kuo-6.21201`) para las
+ * primeras dimensiones: el grado `s` y los coeficientes `a` del polinomio primitivo y
+ * los valores iniciales `m`. La primera dimensión es la secuencia de van der Corput.
+ * Más información -> https://web.maths.unsw.edu.au/~fkuo/sobol/
+ */
+const int GRADO_SOBOL[MAX_DIM_SOBOL] = {0, 1, 2, 3, 3, 4, 4, 5, 5, 5};
+const int COEF_SOBOL[MAX_DIM_SOBOL] = {0, 0, 1, 1, 2, 1, 4, 2, 4, 7};
+const int M_SOBOL[MAX_DIM_SOBOL][5] = {
+    {0, 0, 0, 0, 0}, {1, 0, 0, 0, 0}, {1, 3, 0, 0, 0}, {1, 3, 1, 0, 0}, {1, 1, 1, 0, 0},
+    {1, 1, 3, 3, 0}, {1, 3, 5, 13, 0}, {1, 1, 5, 5, 17}, {1, 1, 5, 5, 5}, {1, 1, 7, 11, 19}
+};
+
+struct DireccionesSobol {
+    uint32_t v[MAX_DIM_SOBOL][BITS_SOBOL];
+};
+
+DireccionesSobol calculaDireccionesSobol(int dim) {
+    DireccionesSobol d;
+    for (int k = 0; k < BITS_SOBOL; k++)
+        d.v[0][k] = 1U << (BITS_SOBOL - 1 - k);
+    for (int j = 1; j < dim; j++) {
+        int s = GRADO_SOBOL[j];
+        for (int k = 0; k < s && k < BITS_SOBOL; k++)
+            d.v[j][k] = (uint32_t) M_SOBOL[j][k] << (BITS_SOBOL - 1 - k);
+        // Recurrencia del polinomio primitivo: v_k = v_{k-s} ^ (v_{k-s} >> s) ^ sum_i a_i v_{k-i}.
+        for (int k = s; k < BITS_SOBOL; k++) {
+            d.v[j][k] = d.v[j][k - s] ^ (d.v[j][k - s] >> s);
+            for (int i = 1; i < s; i++)
+                if ((COEF_SOBOL[j] >> (s - 1 - i)) & 1)
+                    d.v[j][k] ^= d.v[j][k - i];
+        }
+    }
+    return d;
+}
+
+// Coordenada `j` del punto `i` de Sobol: el XOR de los números de dirección de los bits de `i` que valen 1.
+inline double coordenadaSobol(DireccionesSobol const& d, uint64_t i, int j) {
+    uint32_t x = 0;
+    for (int k = 0; i > 0 && k < BITS_SOBOL; i >>= 1, k++)
+        if (i & 1)
+            x ^= d.v[j][k];
+    return x * (1.0 / 4294967296.0);
+}
+
+/*
+ * Quasi-Monte Carlo aleatorizado: evaluamos los puntos `0, 1, ..., N - 1` de la
+ * secuencia (el `0` es el origen en ambas) desplazados con cada uno de los
+ * `DESPLAZAMIENTOS_QMC` vectores aleatorios. Como `N` es siempre una potencia de 2, con
+ * Sobol cada desplazamiento recorre una red `(t, m, s)` completa. Cada desplazamiento
+ * da una estimación independiente de la integral; su media es el resultado y el error
+ * es la mitad del intervalo de confianza del 95%: `T_STUDENT_QMC` veces su desviación
+ * típica entre `sqrt(R)`, ya que con solo `R = 16` muestras la normal se queda corta.
+ * Empezamos con `PUNTOS_INICIALES_QMC` y doblamos `N` hasta alcanzar la tolerancia,
+ * reaprovechando siempre los puntos anteriores. Devolvemos un resultado vacío si la
+ * secuencia no admite tantas dimensiones.
+ */
+template <typename F>
+ResultadoIntegral integralQuasiMonteCarlo(F f, int dim, const double* a, const double* b, double tolerancia,
+                                          long maxPuntos, SecuenciaQMC secuencia = SOBOL, uint64_t semilla = 2022) {
+    ResultadoIntegral r = {0, 0, 0, false};
+    if (dim > (secuencia == SOBOL ? MAX_DIM_SOBOL : MAX_DIM_HALTON))
+        return r;
+
+    DireccionesSobol direcciones = calculaDireccionesSobol(secuencia == SOBOL ? dim : 1);
+    double volumen = volumenCaja(dim, a, b), sumas[DESPLAZAMIENTOS_QMC] = {0};
+    std::vector<double> desplazamiento(DESPLAZAMIENTOS_QMC * dim), u(dim), x(dim);
+    for (int i = 0; i < DESPLAZAMIENTOS_QMC * dim; i++)
+        desplazamiento[i] = uniforme(semilla, i);
+
+    long n = 0;
+    for (long objetivo = PUNTOS_INICIALES_QMC; r.evaluaciones < maxPuntos; objetivo *= 2) {
+        for (; n < objetivo; n++) {
+            for (int j = 0; j < dim; j++)
+                u[j] = secuencia == SOBOL ? coordenadaSobol(direcciones, n, j) : inversaRadical(n, PRIMOS_HALTON[j]);
+            for (int s = 0; s < DESPLAZAMIENTOS_QMC; s++) {
+                for (int j = 0; j < dim; j++) {
+                    double v = u[j] + desplazamiento[s * dim + j];
+                    x[j] = a[j] + (b[j] - a[j]) * (v < 1 ? v : v - 1);
+                }
+                sumas[s] += f(x.data());
+            }
+        }
+
+        Estadistica e = {0, 0, 0};
+        for (int s = 0; s < DESPLAZAMIENTOS_QMC; s++)
+            anadeMuestra(e, volumen * sumas[s] / n);
+        r.valor = e.media;
+        r.error = T_STUDENT_QMC * std::sqrt(e.m2 / (DESPLAZAMIENTOS_QMC - 1) / DESPLAZAMIENTOS_QMC);
+        r.evaluaciones = n * DESPLAZAMIENTOS_QMC;
+        r.convergido = r.error < tolerancia;
+        if (r.convergido)
+            break;
+    }
+    return r;
+}
+
+/*
+ * Muestreo estratificado con `k^dim <= MAX_CELDAS` celdas iguales. En cada ronda
+ * añadimos dos puntos aleatorios a cada celda (hacen falta al menos dos para estimar su
+ * varianza). Si la celda `c` tiene `n` puntos con varianza `s_c^2` y volumen `V_c`, la
+ * varianza del resultado es `sum_c V_c^2 s_c^2 / n`.
+ */
+template <typename F>
+ResultadoIntegral integralEstratificada(F f, int dim, const double* a, const double* b, double tolerancia,
+                                        long maxPuntos, uint64_t semilla = 2022) {
+    long k = 1, celdas = 1;
+    while (std::pow(k + 1, dim) <= MAX_CELDAS)
+        k++;
+    for (int j = 0; j < dim; j++)
+        celdas *= k;
+
+    double volumenCelda = volumenCaja(dim, a, b) / celdas;
+    std::vector<Estadistica> stats(celdas, Estadistica{0, 0, 0});
+    std::vector<long> indice(dim);
+    std::vector<double> x(dim);
+    ResultadoIntegral r = {0, 0, 0, false};
+
+    for (long m = 0; r.evaluaciones < maxPuntos; m += 2) {
+        for (long c = 0; c < celdas; c++) {
+            // El índice de la celda en cada eje son las cifras de `c` en base `k`.
+            for (long j = 0, resto = c; j < dim; j++, resto /= k)
+                indice[j] = resto % k;
+            for (long p = m; p < m + 2; p++) {
+                uint64_t contador = ((uint64_t) p * celdas + c) * dim;
+                for (int j = 0; j < dim; j++)
+                    x[j] = a[j] + (b[j] - a[j]) * (indice[j] + uniforme(semilla, contador + j)) / k;
+                anadeMuestra(stats[c], f(x.data()));
+            }
+        }
+
+        double suma = 0, varianza = 0;
+        for (long c = 0; c < celdas; c++) {
+            suma += stats[c].media;
+            varianza += stats[c].m2 / (stats[c].n - 1) / stats[c].n;
+        }
+        r.evaluaciones = (m + 2) * celdas;
+        r.valor = volumenCelda * suma;
+        r.error = volumenCelda * std::sqrt(varianza);
+        r.convergido = r.error < tolerancia;
+        if (r.convergido)
+            break;
+    }
+    return r;
+}
@@ -1,11 +1,20 @@
 #include <iostream>
+#include <iomanip>
 #include <cmath>
+#include <chrono>
+#include <functional>
 
 #include "integral.cpp"
+#include "integracion.cpp"
+#include "integrandosLote.cpp"
 
 #define A 2.0
 #define B 3.0
 #define N_INTERVALOS 10000
+#define TOLERANCIA 1e-12
+#define N_MEDIDA 10000000
+#define REPETICIONES 5
+#define N_LOTE 4096
 
 double f(double x) {
     return x * exp(-x);
@@ -15,11 +24,100 @@ double g(double x) {
     return x;
 }
 
+// Ejecuta `calcula()` varias veces y devuelve el mejor tiempo por evaluación del integrando en ns.
+template <typename C>
+double mide(C calcula) {
+    double mejor = 0;
+    for (int r = 0; r < REPETICIONES; r++) {
+        std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+        volatile double resultado = calcula();
+        (void) resultado;
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() / N_MEDIDA;
+        if (r == 0 || ns < mejor)
+            mejor = ns;
+    }
+    return mejor;
+}
+
 int main() {
     std::cout << "Integral de f(x) en [" << A << ", " << B << "] = " << integral(f, A, B, N_INTERVALOS) << std::endl;
     std::cout << "Integral de g(x) en [" << A << ", " << B << "] = " << integral(g, A, B, N_INTERVALOS) << std::endl;
     std::cout << "Integral de sin(x) en [0, PI] = " << integral(sin, 0, acos(-1), N_INTERVALOS) << std::endl;
     std::cout << "Integral de sin(x) en [0, 2 * PI] = " << integral(sin, 0, 2 * acos(-1), N_INTERVALOS) << std::endl;
 
+    // La primitiva de x * exp(-x) es -(x + 1) * exp(-x).
+    double exacta = (A + 1) * exp(-A) - (B + 1) * exp(-B);
+    ReglaIntegracion reglas[3] = {TRAPECIO, SIMPSON, GAUSS_LEGENDRE};
+
+    std::cout << std::endl << "Reglas compuestas para f(x) con " << N_INTERVALOS << " subintervalos:" << std::endl;
+    std::cout << "\tRiemann: error = " << std::setprecision(3) << fabs(integral(f, A, B, N_INTERVALOS) - exacta) << std::endl;
+    for (ReglaIntegracion regla : reglas)
+        std::cout << "\t" << nombreRegla(regla) << ": error = "
+                  << fabs(integraCompuesta(f, A, B, N_INTERVALOS, regla) - exacta) << std::endl;
+
+    std::cout << std::endl << "Integración adaptativa de f(x) con tolerancia " << TOLERANCIA << ":" << std::endl;
+    for (ReglaIntegracion regla : reglas) {
+        ResultadoIntegral r = integralAdaptativa(f, A, B, TOLERANCIA, regla);
+        std::cout << "\t" << nombreRegla(regla) << ": " << std::setprecision(15) << r.valor << std::setprecision(3)
+                  << " (error estimado = " << r.error << ", real = " << fabs(r.valor - exacta) << ", "
+                  << r.evaluaciones << " evaluaciones" << (r.convergido ? "" : ", no converge") << ")" << std::endl;
+    }
+
+    ResultadoIntegral r = integralParalela(f, A, B, TOLERANCIA);
+    std::cout << "\tgauss-legendre en paralelo: " << std::setprecision(15) << r.valor << std::setprecision(3)
+              << " (error estimado = " << r.error << ", real = " << fabs(r.valor - exacta) << ", "
+              << r.evaluaciones << " evaluaciones" << (r.convergido ? "" : ", no converge") << ")" << std::endl;
+
+    /*
+     * Comparamos el coste de pasar el integrando como puntero, como lambda (la plantilla
+     * de `integral()` la integra en el bucle) y como `std::function`. Guardamos el puntero
+     * en una variable `volatile` para que el compilador no pueda saber a qué función
+     * apunta, tal y como ocurre cuando `integral()` está en una biblioteca compilada aparte.
+     */
+    double (*volatile punteroF)(double) = f;
+    double (*volatile punteroG)(double) = g;
+    auto lambdaF = [](double x) { return x * exp(-x); };
+    auto lambdaG = [](double x) { return x; };
+    std::function<double(double)> funcionF = f, funcionG = g;
+
+    std::cout << std::endl << "Tiempo por evaluación con " << N_MEDIDA << " subintervalos (ns):" << std::endl;
+    std::cout << "\tg(x) = x: puntero = " << mide([&]() { return integral(punteroG, A, B, N_MEDIDA); })
+              << "; lambda = " << mide([&]() { return integral(lambdaG, A, B, N_MEDIDA); })
+              << "; std::function = " << mide([&]() { return integral(funcionG, A, B, N_MEDIDA); }) << std::endl;
+    std::cout << "\tf(x) = x * exp(-x): puntero = " << mide([&]() { return integral(punteroF, A, B, N_MEDIDA); })
+              << "; lambda = " << mide([&]() { return integral(lambdaF, A, B, N_MEDIDA); })
+              << "; std::function = " << mide([&]() { return integral(funcionF, A, B, N_MEDIDA); }) << std::endl;
+
+    /*
+     * Con los integrandos por lotes cada llamada calcula muchos puntos y `exp()` y `sin()`
+     * se evalúan con instrucciones vectoriales. Primero comprobamos que nuestras versiones
+     * vectoriales coinciden con las de `<cmath>` y después medimos el tiempo por evaluación
+     * con la regla del trapecio frente a la versión punto a punto con una lambda.
+     */
+    double x[N_LOTE], y[N_LOTE], errorExp = 0, errorSin = 0;
+    for (int i = 0; i < N_LOTE; i++)
+        x[i] = -50 + 100.0 * i / N_LOTE;
+    expLote(x, y, N_LOTE);
+    for (int i = 0; i < N_LOTE; i++)
+        errorExp = fmax(errorExp, fabs(y[i] - exp(x[i])) / exp(x[i]));
+    sinLote(x, y, N_LOTE);
+    for (int i = 0; i < N_LOTE; i++)
+        errorSin = fmax(errorSin, fabs(y[i] - sin(x[i])));
+
+    std::cout << std::endl << "Integrandos por lotes (SIMD: " << integrandosSimdNombre() << "):" << std::endl;
+    std::cout << "\tError relativo máximo de exp(x) en [-50, 50] = " << errorExp << std::endl;
+    std::cout << "\tError absoluto máximo de sin(x) en [-50, 50] = " << errorSin << std::endl;
+    for (ReglaIntegracion regla : reglas)
+        std::cout << "\t" << nombreRegla(regla) << ": error = "
+                  << fabs(integraCompuestaPorLotes(xExpLote, A, B, N_INTERVALOS, regla) - exacta) << std::endl;
+
+    auto lambdaSin = [](double x) { return sin(x); };
+    double pi = acos(-1);
+    std::cout << std::endl << "Tiempo por evaluación con la regla del trapecio y " << N_MEDIDA << " subintervalos (ns):" << std::endl;
+    std::cout << "\tf(x) = x * exp(-x): lambda = " << mide([&]() { return trapecio(lambdaF, A, B, N_MEDIDA); })
+              << "; lote = " << mide([&]() { return trapecioPorLotes(xExpLote, A, B, N_MEDIDA); }) << std::endl;
+    std::cout << "\tsin(x): lambda = " << mide([&]() { return trapecio(lambdaSin, 0, pi, N_MEDIDA); })
+              << "; lote = " << mide([&]() { return trapecioPorLotes(sinLote, 0, pi, N_MEDIDA); }) << std::endl;
+
     return 0;
 }
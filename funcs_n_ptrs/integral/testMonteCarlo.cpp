@@ -0,0 +1,53 @@
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+
+#include "integracion.cpp"
+#include "montecarlo.cpp"
+
+#define DIM 4
+#define TOLERANCIA 1e-3
+#define MAX_PUNTOS 50000000
+
+// Producto de `pi / 2 * sin(pi * x_j)`: su integral en el hipercubo unidad vale 1 en cualquier dimensión.
+double f(const double* x) {
+    double p = 1, pi = acos(-1);
+    for (int j = 0; j < DIM; j++)
+        p *= pi / 2 * sin(pi * x[j]);
+    return p;
+}
+
+// Función indicadora de la esfera unidad: su integral en [-1, 1]^3 es el volumen 4 * pi / 3.
+double esfera(const double* x) {
+    return x[0] * x[0] + x[1] * x[1] + x[2] * x[2] <= 1 ? 1 : 0;
+}
+
+void muestra(const char* nombre, ResultadoIntegral r, double exacta) {
+    std::cout << "\t" << nombre << ": " << std::setprecision(10) << r.valor << std::setprecision(3)
+              << " (error estimado = " << r.error << ", real = " << fabs(r.valor - exacta) << ", "
+              << r.evaluaciones << " evaluaciones" << (r.convergido ? "" : ", no converge") << ")" << std::endl;
+}
+
+int main() {
+    double a[DIM] = {0, 0, 0, 0}, b[DIM] = {1, 1, 1, 1};
+    std::cout << "Integral de f(x) en [0, 1]^" << DIM << " con tolerancia " << TOLERANCIA << ":" << std::endl;
+    muestra("monte carlo", integralMonteCarlo(f, DIM, a, b, TOLERANCIA, MAX_PUNTOS), 1);
+    muestra("halton", integralQuasiMonteCarlo(f, DIM, a, b, TOLERANCIA, MAX_PUNTOS, HALTON), 1);
+    muestra("sobol", integralQuasiMonteCarlo(f, DIM, a, b, TOLERANCIA, MAX_PUNTOS, SOBOL), 1);
+    muestra("estratificado", integralEstratificada(f, DIM, a, b, TOLERANCIA, MAX_PUNTOS), 1);
+
+    double c[3] = {-1, -1, -1}, d[3] = {1, 1, 1}, volumen = 4 * acos(-1) / 3;
+    std::cout << std::endl << "Volumen de la esfera unidad con tolerancia " << TOLERANCIA << ":" << std::endl;
+    muestra("monte carlo", integralMonteCarlo(esfera, 3, c, d, TOLERANCIA, MAX_PUNTOS), volumen);
+    muestra("halton", integralQuasiMonteCarlo(esfera, 3, c, d, TOLERANCIA, MAX_PUNTOS, HALTON), volumen);
+    muestra("sobol", integralQuasiMonteCarlo(esfera, 3, c, d, TOLERANCIA, MAX_PUNTOS, SOBOL), volumen);
+    muestra("estratificado", integralEstratificada(esfera, 3, c, d, TOLERANCIA, MAX_PUNTOS), volumen);
+
+    // Cada punto depende solo de su posición en la secuencia: con 1, 2 o 4 hilos el resultado es idéntico.
+    std::cout << std::endl << "Monte Carlo con distinto número de hilos:" << std::endl << std::setprecision(17);
+    for (unsigned hilos = 1; hilos <= 4; hilos *= 2)
+        std::cout << "\t" << hilos << " hilo(s): " << integralMonteCarlo(f, DIM, a, b, TOLERANCIA, MAX_PUNTOS, hilos).valor
+                  << std::endl;
+
+    return 0;
+}
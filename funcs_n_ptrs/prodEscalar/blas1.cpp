@@ -0,0 +1,576 @@
+/*
+ * Pequeña biblioteca con las operaciones de «nivel 1» de BLAS, i.e. las que trabajan
+ * sobre vectores (https://netlib.org/blas/):
+ *  - dot(x, y)    = sum_i x_i y_i           (el producto escalar de `prodEscalar()`)
+ *  - axpy(a, x, y):  y_i <- a x_i + y_i
+ *  - scal(a, x):     x_i <- a x_i
+ *  - nrm2(x)      = sqrt(sum_i x_i^2)
+ *  - asum(x)      = sum_i |x_i|
+ * Frente a `prodEscalar()`:
+ *  - Las longitudes son `size_t`: un `int` no llega más allá de unos 2 * 10^9 elementos.
+ *  - Cada operación tiene una versión escalar, una AVX2 (4 `double`s) y una AVX-512
+ *    (8 `double`s), todas con varios acumuladores independientes para que una suma no
+ *    espere a la anterior.
+ *  - La versión se elige al ejecutar según lo que soporte el procesador: compilamos
+ *    cada núcleo con `__attribute__((target(...)))`, preguntamos al procesador con
+ *    `__builtin_cpu_supports()` y guardamos punteros a las funciones elegidas. Así el
+ *    mismo ejecutable aprovecha AVX-512 donde lo hay sin necesitar `-march=native`.
+ *  - Por encima de `UMBRAL_PARALELO` elementos repartimos el vector entre varios hilos.
+ *  - El producto escalar admite varias precisiones (ver `PrecisionDot`): con datos
+ *    `float` podemos acumular en `float` (el doble de elementos por instrucción y la
+ *    mitad de memoria que leer) o en `double`, y con datos `double` podemos usar un
+ *    algoritmo compensado que da el resultado como si hubiéramos calculado con el
+ *    doble de precisión.
+ * Para compilar hay que pasar `-pthread` a `g++`.
+ */
+
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include <immintrin.h>
+
+// Alineamiento de `reservaAlineada()`: una línea de caché y un registro AVX-512.
+#define ALINEAMIENTO 64
+#define UMBRAL_PARALELO (1 << 20)
+
+/*
+ * Reserva `n` elementos de tipo `T` (`double` si no decimos otra cosa) alineados a
+ * `ALINEAMIENTO` bytes, de modo que cada carga vectorial lea una sola línea de caché.
+ * Se liberan con `liberaAlineada()`.
+ */
+template <typename T = double>
+T* reservaAlineada(size_t n) {
+    void* p = nullptr;
+    if (posix_memalign(&p, ALINEAMIENTO, n * sizeof(T)) != 0)
+        return nullptr;
+    return (T*) p;
+}
+
+void liberaAlineada(void* p) {
+    free(p);
+}
+
+/*
+ * Precisión del producto escalar:
+ *  - DOT_FLOAT: datos y acumuladores `float`. Es el más rápido, pero con solo ~7 cifras
+ *    el error crece enseguida con la longitud del vector.
+ *  - DOT_MIXTA: datos `float` y acumuladores `double`. El producto de dos `float` cabe
+ *    exacto en un `double`, con lo que solo hay errores en la suma.
+ *  - DOT_DOBLE: todo en `double` (con datos `float` es lo mismo que `DOT_MIXTA`).
+ *  - DOT_COMPENSADA: el algoritmo Dot2 de Ogita, Rump y Oishi: con una FMA obtenemos el
+ *    error exacto de cada producto y con el «TwoSum» de Knuth el de cada suma, y los
+ *    acumulamos aparte. El resultado es tan preciso como si hubiéramos usado el doble
+ *    de cifras y luego redondeado, a cambio de unas 4 veces más operaciones.
+ *    Más información -> https://doi.org/10.1137/030601818
+ */
+enum PrecisionDot {DOT_FLOAT, DOT_MIXTA, DOT_DOBLE, DOT_COMPENSADA};
+
+const char* nombrePrecisionDot(PrecisionDot precision) {
+    switch (precision) {
+        case DOT_FLOAT:
+            return "float";
+        case DOT_MIXTA:
+            return "mixta";
+        case DOT_DOBLE:
+            return "doble";
+        default:
+            return "compensada";
+    }
+}
+
+// Una suma y el error acumulado que le falta para ser exacta: el resultado es `s + c`.
+struct SumaCompensada {
+    double s, c;
+};
+
+// TwoSum de Knuth: `a + b = s + e` exactamente, sea cual sea el orden de magnitud de `a` y `b`.
+inline void dosSumas(double a, double b, double& s, double& e) {
+    s = a + b;
+    double z = s - a;
+    e = (a - (s - z)) + (b - z);
+}
+
+inline SumaCompensada combinaCompensadas(SumaCompensada x, SumaCompensada y) {
+    SumaCompensada r;
+    double e;
+    dosSumas(x.s, y.s, r.s, e);
+    r.c = x.c + y.c + e;
+    return r;
+}
+
+// Versiones escalares. Son también las que completan los elementos que no llenan un vector.
+double dotEscalar(const double* x, const double* y, size_t n) {
+    double s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        s0 += x[i] * y[i];
+        s1 += x[i + 1] * y[i + 1];
+        s2 += x[i + 2] * y[i + 2];
+        s3 += x[i + 3] * y[i + 3];
+    }
+    for (; i < n; i++)
+        s0 += x[i] * y[i];
+    return (s0 + s1) + (s2 + s3);
+}
+
+float dotFloatEscalar(const float* x, const float* y, size_t n) {
+    float s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        s0 += x[i] * y[i];
+        s1 += x[i + 1] * y[i + 1];
+        s2 += x[i + 2] * y[i + 2];
+        s3 += x[i + 3] * y[i + 3];
+    }
+    for (; i < n; i++)
+        s0 += x[i] * y[i];
+    return (s0 + s1) + (s2 + s3);
+}
+
+double dotMixtaEscalar(const float* x, const float* y, size_t n) {
+    double s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        s0 += (double) x[i] * y[i];
+        s1 += (double) x[i + 1] * y[i + 1];
+        s2 += (double) x[i + 2] * y[i + 2];
+        s3 += (double) x[i + 3] * y[i + 3];
+    }
+    for (; i < n; i++)
+        s0 += (double) x[i] * y[i];
+    return (s0 + s1) + (s2 + s3);
+}
+
+SumaCompensada dotCompensadoEscalar(const double* x, const double* y, size_t n) {
+    SumaCompensada r = {0, 0};
+    for (size_t i = 0; i < n; i++) {
+        double p = x[i] * y[i], ep = std::fma(x[i], y[i], -p), q;
+        dosSumas(r.s, p, r.s, q);
+        r.c += q + ep;
+    }
+    return r;
+}
+
+void axpyEscalar(double a, const double* x, double* y, size_t n) {
+    for (size_t i = 0; i < n; i++)
+        y[i] += a * x[i];
+}
+
+void scalEscalar(double a, double* x, size_t n) {
+    for (size_t i = 0; i < n; i++)
+        x[i] *= a;
+}
+
+double asumEscalar(const double* x, size_t n) {
+    double s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        s0 += std::fabs(x[i]);
+        s1 += std::fabs(x[i + 1]);
+        s2 += std::fabs(x[i + 2]);
+        s3 += std::fabs(x[i + 3]);
+    }
+    for (; i < n; i++)
+        s0 += std::fabs(x[i]);
+    return (s0 + s1) + (s2 + s3);
+}
+
+/*
+ * GCC 12 avisa de un `-Wmaybe-uninitialized` falso dentro de sus propias cabeceras de
+ * AVX-512 (ver `integral/integrandosLote.cpp`). Lo silenciamos solo en los núcleos.
+ */
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+#define AVX2 __attribute__((target("avx2,fma")))
+#define AVX512 __attribute__((target("avx512f")))
+
+AVX2 double sumaVector(__m256d v) {
+    double parcial[4];
+    _mm256_storeu_pd(parcial, v);
+    return (parcial[0] + parcial[1]) + (parcial[2] + parcial[3]);
+}
+
+AVX2 double dotAvx2(const double* x, const double* y, size_t n) {
+    __m256d s0 = _mm256_setzero_pd(), s1 = _mm256_setzero_pd(), s2 = _mm256_setzero_pd(), s3 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        s0 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i), s0);
+        s1 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i + 4), _mm256_loadu_pd(y + i + 4), s1);
+        s2 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i + 8), _mm256_loadu_pd(y + i + 8), s2);
+        s3 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i + 12), _mm256_loadu_pd(y + i + 12), s3);
+    }
+    return sumaVector(_mm256_add_pd(_mm256_add_pd(s0, s1), _mm256_add_pd(s2, s3))) + dotEscalar(x + i, y + i, n - i);
+}
+
+AVX2 float sumaVector(__m256 v) {
+    float parcial[8];
+    _mm256_storeu_ps(parcial, v);
+    return ((parcial[0] + parcial[1]) + (parcial[2] + parcial[3])) + ((parcial[4] + parcial[5]) + (parcial[6] + parcial[7]));
+}
+
+AVX2 float dotFloatAvx2(const float* x, const float* y, size_t n) {
+    __m256 s0 = _mm256_setzero_ps(), s1 = _mm256_setzero_ps(), s2 = _mm256_setzero_ps(), s3 = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        s0 = _mm256_fmadd_ps(_mm256_loadu_ps(x + i), _mm256_loadu_ps(y + i), s0);
+        s1 = _mm256_fmadd_ps(_mm256_loadu_ps(x + i + 8), _mm256_loadu_ps(y + i + 8), s1);
+        s2 = _mm256_fmadd_ps(_mm256_loadu_ps(x + i + 16), _mm256_loadu_ps(y + i + 16), s2);
+        s3 = _mm256_fmadd_ps(_mm256_loadu_ps(x + i + 24), _mm256_loadu_ps(y + i + 24), s3);
+    }
+    return sumaVector(_mm256_add_ps(_mm256_add_ps(s0, s1), _mm256_add_ps(s2, s3))) + dotFloatEscalar(x + i, y + i, n - i);
+}
+
+// Convertimos cada grupo de 4 `float`s en 4 `double`s antes de multiplicar.
+AVX2 double dotMixtaAvx2(const float* x, const float* y, size_t n) {
+    __m256d s0 = _mm256_setzero_pd(), s1 = _mm256_setzero_pd(), s2 = _mm256_setzero_pd(), s3 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        s0 = _mm256_fmadd_pd(_mm256_cvtps_pd(_mm_loadu_ps(x + i)), _mm256_cvtps_pd(_mm_loadu_ps(y + i)), s0);
+        s1 = _mm256_fmadd_pd(_mm256_cvtps_pd(_mm_loadu_ps(x + i + 4)), _mm256_cvtps_pd(_mm_loadu_ps(y + i + 4)), s1);
+        s2 = _mm256_fmadd_pd(_mm256_cvtps_pd(_mm_loadu_ps(x + i + 8)), _mm256_cvtps_pd(_mm_loadu_ps(y + i + 8)), s2);
+        s3 = _mm256_fmadd_pd(_mm256_cvtps_pd(_mm_loadu_ps(x + i + 12)), _mm256_cvtps_pd(_mm_loadu_ps(y + i + 12)), s3);
+    }
+    return sumaVector(_mm256_add_pd(_mm256_add_pd(s0, s1), _mm256_add_pd(s2, s3))) + dotMixtaEscalar(x + i, y + i, n - i);
+}
+
+/*
+ * Dot2 con 4 sumas compensadas independientes (una por componente del vector). Al
+ * final las combinamos entre sí, también de forma compensada.
+ */
+AVX2 SumaCompensada dotCompensadoAvx2(const double* x, const double* y, size_t n) {
+    __m256d s = _mm256_setzero_pd(), c = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d a = _mm256_loadu_pd(x + i), b = _mm256_loadu_pd(y + i);
+        __m256d p = _mm256_mul_pd(a, b), ep = _mm256_fmsub_pd(a, b, p);
+        __m256d t = _mm256_add_pd(s, p), z = _mm256_sub_pd(t, s);
+        __m256d q = _mm256_add_pd(_mm256_sub_pd(s, _mm256_sub_pd(t, z)), _mm256_sub_pd(p, z));
+        s = t;
+        c = _mm256_add_pd(c, _mm256_add_pd(q, ep));
+    }
+
+    double vs[4], vc[4];
+    _mm256_storeu_pd(vs, s);
+    _mm256_storeu_pd(vc, c);
+    SumaCompensada r = dotCompensadoEscalar(x + i, y + i, n - i);
+    for (int k = 0; k < 4; k++)
+        r = combinaCompensadas(r, SumaCompensada{vs[k], vc[k]});
+    return r;
+}
+
+AVX2 void axpyAvx2(double a, const double* x, double* y, size_t n) {
+    __m256d va = _mm256_set1_pd(a);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+        _mm256_storeu_pd(y + i, _mm256_fmadd_pd(va, _mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i)));
+    axpyEscalar(a, x + i, y + i, n - i);
+}
+
+AVX2 void scalAvx2(double a, double* x, size_t n) {
+    __m256d va = _mm256_set1_pd(a);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+        _mm256_storeu_pd(x + i, _mm256_mul_pd(va, _mm256_loadu_pd(x + i)));
+    scalEscalar(a, x + i, n - i);
+}
+
+// `|x|` es `x` con el bit de signo a 0: hacemos un AND con todos los bits a 1 salvo ese.
+AVX2 double asumAvx2(const double* x, size_t n) {
+    __m256d mascara = _mm256_castsi256_pd(_mm256_set1_epi64x(0x7FFFFFFFFFFFFFFFLL));
+    __m256d s0 = _mm256_setzero_pd(), s1 = _mm256_setzero_pd(), s2 = _mm256_setzero_pd(), s3 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        s0 = _mm256_add_pd(s0, _mm256_and_pd(mascara, _mm256_loadu_pd(x + i)));
+        s1 = _mm256_add_pd(s1, _mm256_and_pd(mascara, _mm256_loadu_pd(x + i + 4)));
+        s2 = _mm256_add_pd(s2, _mm256_and_pd(mascara, _mm256_loadu_pd(x + i + 8)));
+        s3 = _mm256_add_pd(s3, _mm256_and_pd(mascara, _mm256_loadu_pd(x + i + 12)));
+    }
+    return sumaVector(_mm256_add_pd(_mm256_add_pd(s0, s1), _mm256_add_pd(s2, s3))) + asumEscalar(x + i, n - i);
+}
+
+AVX512 double sumaVector(__m512d v) {
+    double parcial[8];
+    _mm512_storeu_pd(parcial, v);
+    return ((parcial[0] + parcial[1]) + (parcial[2] + parcial[3])) + ((parcial[4] + parcial[5]) + (parcial[6] + parcial[7]));
+}
+
+AVX512 double dotAvx512(const double* x, const double* y, size_t n) {
+    __m512d s0 = _mm512_setzero_pd(), s1 = _mm512_setzero_pd(), s2 = _mm512_setzero_pd(), s3 = _mm512_setzero_pd();
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        s0 = _mm512_fmadd_pd(_mm512_loadu_pd(x + i), _mm512_loadu_pd(y + i), s0);
+        s1 = _mm512_fmadd_pd(_mm512_loadu_pd(x + i + 8), _mm512_loadu_pd(y + i + 8), s1);
+        s2 = _mm512_fmadd_pd(_mm512_loadu_pd(x + i + 16), _mm512_loadu_pd(y + i + 16), s2);
+        s3 = _mm512_fmadd_pd(_mm512_loadu_pd(x + i + 24), _mm512_loadu_pd(y + i + 24), s3);
+    }
+    return sumaVector(_mm512_add_pd(_mm512_add_pd(s0, s1), _mm512_add_pd(s2, s3))) + dotEscalar(x + i, y + i, n - i);
+}
+
+AVX512 float sumaVector(__m512 v) {
+    float parcial[16], suma = 0;
+    _mm512_storeu_ps(parcial, v);
+    for (int k = 0; k < 16; k++)
+        suma += parcial[k];
+    return suma;
+}
+
+AVX512 float dotFloatAvx512(const float* x, const float* y, size_t n) {
+    __m512 s0 = _mm512_setzero_ps(), s1 = _mm512_setzero_ps(), s2 = _mm512_setzero_ps(), s3 = _mm512_setzero_ps();
+    size_t i = 0;
+    for (; i + 64 <= n; i += 64) {
+        s0 = _mm512_fmadd_ps(_mm512_loadu_ps(x + i), _mm512_loadu_ps(y + i), s0);
+        s1 = _mm512_fmadd_ps(_mm512_loadu_ps(x + i + 16), _mm512_loadu_ps(y + i + 16), s1);
+        s2 = _mm512_fmadd_ps(_mm512_loadu_ps(x + i + 32), _mm512_loadu_ps(y + i + 32), s2);
+        s3 = _mm512_fmadd_ps(_mm512_loadu_ps(x + i + 48), _mm512_loadu_ps(y + i + 48), s3);
+    }
+    return sumaVector(_mm512_add_ps(_mm512_add_ps(s0, s1), _mm512_add_ps(s2, s3))) + dotFloatEscalar(x + i, y + i, n - i);
+}
+
+AVX512 double dotMixtaAvx512(const float* x, const float* y, size_t n) {
+    __m512d s0 = _mm512_setzero_pd(), s1 = _mm512_setzero_pd(), s2 = _mm512_setzero_pd(), s3 = _mm512_setzero_pd();
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        s0 = _mm512_fmadd_pd(_mm512_cvtps_pd(_mm256_loadu_ps(x + i)), _mm512_cvtps_pd(_mm256_loadu_ps(y + i)), s0);
+        s1 = _mm512_fmadd_pd(_mm512_cvtps_pd(_mm256_loadu_ps(x + i + 8)), _mm512_cvtps_pd(_mm256_loadu_ps(y + i + 8)), s1);
+        s2 = _mm512_fmadd_pd(_mm512_cvtps_pd(_mm256_loadu_ps(x + i + 16)), _mm512_cvtps_pd(_mm256_loadu_ps(y + i + 16)), s2);
+        s3 = _mm512_fmadd_pd(_mm512_cvtps_pd(_mm256_loadu_ps(x + i + 24)), _mm512_cvtps_pd(_mm256_loadu_ps(y + i + 24)), s3);
+    }
+    return sumaVector(_mm512_add_pd(_mm512_add_pd(s0, s1), _mm512_add_pd(s2, s3))) + dotMixtaEscalar(x + i, y + i, n - i);
+}
+
+AVX512 SumaCompensada dotCompensadoAvx512(const double* x, const double* y, size_t n) {
+    __m512d s = _mm512_setzero_pd(), c = _mm512_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m512d a = _mm512_loadu_pd(x + i), b = _mm512_loadu_pd(y + i);
+        __m512d p = _mm512_mul_pd(a, b), ep = _mm512_fmsub_pd(a, b, p);
+        __m512d t = _mm512_add_pd(s, p), z = _mm512_sub_pd(t, s);
+        __m512d q = _mm512_add_pd(_mm512_sub_pd(s, _mm512_sub_pd(t, z)), _mm512_sub_pd(p, z));
+        s = t;
+        c = _mm512_add_pd(c, _mm512_add_pd(q, ep));
+    }
+
+    double vs[8], vc[8];
+    _mm512_storeu_pd(vs, s);
+    _mm512_storeu_pd(vc, c);
+    SumaCompensada r = dotCompensadoEscalar(x + i, y + i, n - i);
+    for (int k = 0; k < 8; k++)
+        r = combinaCompensadas(r, SumaCompensada{vs[k], vc[k]});
+    return r;
+}
+
+AVX512 void axpyAvx512(double a, const double* x, double* y, size_t n) {
+    __m512d va = _mm512_set1_pd(a);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+        _mm512_storeu_pd(y + i, _mm512_fmadd_pd(va, _mm512_loadu_pd(x + i), _mm512_loadu_pd(y + i)));
+    axpyEscalar(a, x + i, y + i, n - i);
+}
+
+AVX512 void scalAvx512(double a, double* x, size_t n) {
+    __m512d va = _mm512_set1_pd(a);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+        _mm512_storeu_pd(x + i, _mm512_mul_pd(va, _mm512_loadu_pd(x + i)));
+    scalEscalar(a, x + i, n - i);
+}
+
+AVX512 double asumAvx512(const double* x, size_t n) {
+    __m512d s0 = _mm512_setzero_pd(), s1 = _mm512_setzero_pd(), s2 = _mm512_setzero_pd(), s3 = _mm512_setzero_pd();
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        s0 = _mm512_add_pd(s0, _mm512_abs_pd(_mm512_loadu_pd(x + i)));
+        s1 = _mm512_add_pd(s1, _mm512_abs_pd(_mm512_loadu_pd(x + i + 8)));
+        s2 = _mm512_add_pd(s2, _mm512_abs_pd(_mm512_loadu_pd(x + i + 16)));
+        s3 = _mm512_add_pd(s3, _mm512_abs_pd(_mm512_loadu_pd(x + i + 24)));
+    }
+    return sumaVector(_mm512_add_pd(_mm512_add_pd(s0, s1), _mm512_add_pd(s2, s3))) + asumEscalar(x + i, n - i);
+}
+
+#undef AVX2
+#undef AVX512
+#pragma GCC diagnostic pop
+
+/*
+ * Los núcleos que usaremos, elegidos una única vez (la primera vez que se llama a
+ * `nucleosBlas1()`; desde C++11 la inicialización de una variable `static` local es
+ * segura aunque la hagan varios hilos a la vez).
+ */
+struct NucleosBlas1 {
+    const char* nombre;
+    double (*dot)(const double*, const double*, size_t);
+    void (*axpy)(double, const double*, double*, size_t);
+    void (*scal)(double, double*, size_t);
+    double (*asum)(const double*, size_t);
+    float (*dotFloat)(const float*, const float*, size_t);
+    double (*dotMixta)(const float*, const float*, size_t);
+    SumaCompensada (*dotCompensado)(const double*, const double*, size_t);
+};
+
+NucleosBlas1 eligeNucleosBlas1() {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+        return NucleosBlas1{"AVX-512", dotAvx512, axpyAvx512, scalAvx512, asumAvx512,
+                            dotFloatAvx512, dotMixtaAvx512, dotCompensadoAvx512};
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+        return NucleosBlas1{"AVX2", dotAvx2, axpyAvx2, scalAvx2, asumAvx2,
+                            dotFloatAvx2, dotMixtaAvx2, dotCompensadoAvx2};
+    return NucleosBlas1{"ninguno (escalar)", dotEscalar, axpyEscalar, scalEscalar, asumEscalar,
+                        dotFloatEscalar, dotMixtaEscalar, dotCompensadoEscalar};
+}
+
+NucleosBlas1 const& nucleosBlas1() {
+    static const NucleosBlas1 nucleos = eligeNucleosBlas1();
+    return nucleos;
+}
+
+const char* blas1SimdNombre() {
+    return nucleosBlas1().nombre;
+}
+
+/*
+ * Divide `[0, n)` en `hilos` trozos contiguos (`0` usa todos los núcleos, y por debajo
+ * de `UMBRAL_PARALELO` usamos uno solo: lanzar hilos cuesta más que lo que ahorran) y
+ * llama a `trozo(ini, fin, t)` en el hilo `t`. Devuelve el número de hilos usados.
+ * Los trozos son múltiplos de `ALINEAMIENTO / tamElemento` elementos (8 `double` o 16
+ * `float`) para que ningún hilo empiece a mitad de una línea de caché de un vector alineado.
+ */
+template <typename T>
+unsigned repartePorTrozos(T trozo, size_t n, unsigned hilos, size_t tamElemento = sizeof(double)) {
+    if (hilos == 0)
+        hilos = std::thread::hardware_concurrency();
+    if (hilos == 0 || n < UMBRAL_PARALELO)
+        hilos = 1;
+    if (hilos == 1) {
+        trozo(0, n, 0);
+        return 1;
+    }
+
+    size_t porLinea = ALINEAMIENTO / tamElemento, paso = (n / hilos + porLinea - 1) / porLinea * porLinea;
+    std::vector<std::thread> trabajadores;
+    for (unsigned t = 0; t < hilos; t++) {
+        size_t ini = t * paso < n ? t * paso : n, fin = t + 1 == hilos || (t + 1) * paso > n ? n : (t + 1) * paso;
+        trabajadores.push_back(std::thread(trozo, ini, fin, t));
+    }
+    for (unsigned t = 0; t < hilos; t++)
+        trabajadores[t].join();
+    return hilos;
+}
+
+// Suma los resultados parciales de cada hilo siempre en el mismo orden.
+inline double sumaParciales(std::vector<double> const& parciales, unsigned usados) {
+    double suma = 0;
+    for (unsigned t = 0; t < usados; t++)
+        suma += parciales[t];
+    return suma;
+}
+
+double dot(const double* x, const double* y, size_t n, unsigned hilos = 0) {
+    std::vector<double> parciales(hilos ? hilos : std::thread::hardware_concurrency() + 1);
+    unsigned usados = repartePorTrozos([&](size_t ini, size_t fin, unsigned t) {
+        parciales[t] = nucleosBlas1().dot(x + ini, y + ini, fin - ini);
+    }, n, hilos);
+    return sumaParciales(parciales, usados);
+}
+
+// Con datos `double` solo tiene sentido elegir entre `DOT_COMPENSADA` y el producto normal.
+double dot(const double* x, const double* y, size_t n, PrecisionDot precision, unsigned hilos = 0) {
+    if (precision != DOT_COMPENSADA)
+        return dot(x, y, n, hilos);
+
+    std::vector<SumaCompensada> parciales(hilos ? hilos : std::thread::hardware_concurrency() + 1);
+    unsigned usados = repartePorTrozos([&](size_t ini, size_t fin, unsigned t) {
+        parciales[t] = nucleosBlas1().dotCompensado(x + ini, y + ini, fin - ini);
+    }, n, hilos);
+    SumaCompensada r = {0, 0};
+    for (unsigned t = 0; t < usados; t++)
+        r = combinaCompensadas(r, parciales[t]);
+    return r.s + r.c;
+}
+
+// Con `DOT_COMPENSADA` convertimos los datos a `double` por bloques que caben en la caché L1.
+#define BLOQUE_CONVERSION 1024
+
+SumaCompensada dotCompensadoFloat(const float* x, const float* y, size_t n) {
+    double bx[BLOQUE_CONVERSION], by[BLOQUE_CONVERSION];
+    SumaCompensada r = {0, 0};
+    for (size_t i0 = 0; i0 < n; i0 += BLOQUE_CONVERSION) {
+        size_t m = n - i0 < BLOQUE_CONVERSION ? n - i0 : BLOQUE_CONVERSION;
+        for (size_t k = 0; k < m; k++) {
+            bx[k] = x[i0 + k];
+            by[k] = y[i0 + k];
+        }
+        r = combinaCompensadas(r, nucleosBlas1().dotCompensado(bx, by, m));
+    }
+    return r;
+}
+
+double dot(const float* x, const float* y, size_t n, PrecisionDot precision = DOT_MIXTA, unsigned hilos = 0) {
+    std::vector<SumaCompensada> parciales(hilos ? hilos : std::thread::hardware_concurrency() + 1);
+    unsigned usados = repartePorTrozos([&](size_t ini, size_t fin, unsigned t) {
+        SumaCompensada parcial = {0, 0};
+        if (precision == DOT_FLOAT)
+            parcial.s = nucleosBlas1().dotFloat(x + ini, y + ini, fin - ini);
+        else if (precision == DOT_COMPENSADA)
+            parcial = dotCompensadoFloat(x + ini, y + ini, fin - ini);
+        else
+            parcial.s = nucleosBlas1().dotMixta(x + ini, y + ini, fin - ini);
+        parciales[t] = parcial;
+    }, n, hilos, sizeof(float));
+    SumaCompensada r = {0, 0};
+    for (unsigned t = 0; t < usados; t++)
+        r = combinaCompensadas(r, parciales[t]);
+    // Con `DOT_FLOAT` devolvemos el resultado redondeado a `float`, que es la precisión con la que se ha calculado.
+    return precision == DOT_FLOAT ? (float) (r.s + r.c) : r.s + r.c;
+}
+
+void axpy(double a, const double* x, double* y, size_t n, unsigned hilos = 0) {
+    repartePorTrozos([&](size_t ini, size_t fin, unsigned) {
+        nucleosBlas1().axpy(a, x + ini, y + ini, fin - ini);
+    }, n, hilos);
+}
+
+void scal(double a, double* x, size_t n, unsigned hilos = 0) {
+    repartePorTrozos([&](size_t ini, size_t fin, unsigned) {
+        nucleosBlas1().scal(a, x + ini, fin - ini);
+    }, n, hilos);
+}
+
+double asum(const double* x, size_t n, unsigned hilos = 0) {
+    std::vector<double> parciales(hilos ? hilos : std::thread::hardware_concurrency() + 1);
+    unsigned usados = repartePorTrozos([&](size_t ini, size_t fin, unsigned t) {
+        parciales[t] = nucleosBlas1().asum(x + ini, fin - ini);
+    }, n, hilos);
+    return sumaParciales(parciales, usados);
+}
+
+/*
+ * `sqrt(dot(x, x))` es rápido pero puede desbordar (si algún `|x_i|` ronda `1e154`) o
+ * perder todos los dígitos (si rondan `1e-160`). En ese caso, que detectamos porque el
+ * resultado sale infinito o menor que el menor `double` normalizado, repetimos el
+ * cálculo dividiendo antes todo el vector por su mayor componente. Si algún `x_i` es
+ * NaN la suma también lo es y lo devolvemos tal cual, como la BLAS de referencia:
+ * `std::fmax()` ignora los NaN y un vector de NaN daría 0.
+ */
+double nrm2(const double* x, size_t n, unsigned hilos = 0) {
+    double suma = dot(x, x, n, hilos);
+    if (std::isnan(suma))
+        return suma;
+    if (std::isfinite(suma) && suma >= 2.2250738585072014e-308)
+        return std::sqrt(suma);
+
+    double maximo = 0;
+    for (size_t i = 0; i < n; i++)
+        maximo = std::fmax(maximo, std::fabs(x[i]));
+    if (maximo == 0 || !std::isfinite(maximo))
+        return maximo;
+
+    suma = 0;
+    for (size_t i = 0; i < n; i++)
+        suma += (x[i] / maximo) * (x[i] / maximo);
+    return maximo * std::sqrt(suma);
+}
@@ -0,0 +1,224 @@
+/*
+ * Vectores y matrices «dispersos»: cuando casi todos los elementos son 0 no tiene
+ * sentido guardarlos ni multiplicarlos. Guardamos solo los no nulos como parejas
+ * (índice, valor), ordenadas por índice:
+ *      x = [0, 0, 3, 0, 0, 0, 7, 0]  ->  indices = {2, 6}, valores = {3, 7}
+ * Los índices son `uint32_t`: llegan hasta ~4 * 10^9 y ocupan la mitad que un `size_t`,
+ * que importa porque estos productos están limitados por la memoria que hay que leer.
+ * `comprime()` y `comprimeMatriz()` lanzan `std::length_error` si no caben.
+ *
+ * Ofrecemos:
+ *  - Disperso por denso: recorremos los no nulos y «recogemos» el elemento del vector
+ *    denso correspondiente. Cuesta `nnz` accesos en vez de `n`.
+ *  - Disperso por disperso «por mezcla»: como en el `merge` de dos listas ordenadas
+ *    avanzamos en la que tenga el índice menor. Cuesta `nnz(x) + nnz(y)`.
+ *  - Disperso por disperso con un mapa de bits: «esparcimos» uno de los vectores en un
+ *    espacio de trabajo denso y marcamos sus índices en un mapa de bits (`n / 8`
+ *    bytes, que sí cabe en caché). El otro vector solo consulta el mapa y lee el valor
+ *    cuando el bit está a 1. Conviene cuando un vector tiene muchos más no nulos que
+ *    el otro o cuando multiplicamos el mismo vector por muchos otros.
+ *  - Matrices en formato CSR («compressed sparse row»): cada fila es un vector disperso
+ *    y el producto matriz-vector es un producto disperso por denso por fila.
+ *    Más información -> https://en.wikipedia.org/wiki/Sparse_matrix
+ * Para compilar hay que pasar `-pthread` a `g++`.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+struct VectorDisperso {
+    size_t dim;
+    std::vector<uint32_t> indices;
+    std::vector<double> valores;
+};
+
+// Comprueba que los índices `[0, n)` caben en un `uint32_t` antes de guardarlos.
+void compruebaIndices(size_t n) {
+    if (n > 0 && n - 1 > UINT32_MAX)
+        throw std::length_error("sparse indices do not fit in 32 bits");
+}
+
+// Se queda con los elementos no nulos de `x`.
+VectorDisperso comprime(const double* x, size_t n) {
+    compruebaIndices(n);
+    VectorDisperso v;
+    v.dim = n;
+    for (size_t i = 0; i < n; i++)
+        if (x[i] != 0) {
+            v.indices.push_back(i);
+            v.valores.push_back(x[i]);
+        }
+    return v;
+}
+
+// Escribe `v` en `x`, que ha de tener `v.dim` elementos.
+void expande(VectorDisperso const& v, double* x) {
+    for (size_t i = 0; i < v.dim; i++)
+        x[i] = 0;
+    for (size_t k = 0; k < v.indices.size(); k++)
+        x[v.indices[k]] = v.valores[k];
+}
+
+double densidad(VectorDisperso const& v) {
+    return v.dim ? double(v.indices.size()) / v.dim : 0;
+}
+
+/*
+ * `sum_k valores[k] * y[indices[k]]`. Trabaja sobre punteros para poder usarlo también
+ * con las filas de una matriz CSR. Con 4 acumuladores los accesos a `y`, que son
+ * aleatorios, pueden solaparse.
+ */
+double dotDispersoDenso(const uint32_t* indices, const double* valores, size_t nnz, const double* y) {
+    double s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    size_t k = 0;
+    for (; k + 4 <= nnz; k += 4) {
+        s0 += valores[k] * y[indices[k]];
+        s1 += valores[k + 1] * y[indices[k + 1]];
+        s2 += valores[k + 2] * y[indices[k + 2]];
+        s3 += valores[k + 3] * y[indices[k + 3]];
+    }
+    for (; k < nnz; k++)
+        s0 += valores[k] * y[indices[k]];
+    return (s0 + s1) + (s2 + s3);
+}
+
+double dot(VectorDisperso const& x, const double* y) {
+    return dotDispersoDenso(x.indices.data(), x.valores.data(), x.indices.size(), y);
+}
+
+/*
+ * Mezcla de dos listas ordenadas. En vez de un `if` con tres ramas (que el procesador
+ * predice mal, porque qué lista avanza es casi aleatorio) avanzamos cada índice con el
+ * resultado de la comparación convertido a 0 o 1.
+ */
+double dotMezcla(VectorDisperso const& x, VectorDisperso const& y) {
+    const uint32_t* ix = x.indices.data();
+    const uint32_t* iy = y.indices.data();
+    size_t i = 0, j = 0, nx = x.indices.size(), ny = y.indices.size();
+    double suma = 0;
+    while (i < nx && j < ny) {
+        uint32_t a = ix[i], b = iy[j];
+        if (a == b)
+            suma += x.valores[i] * y.valores[j];
+        i += a <= b;
+        j += b <= a;
+    }
+    return suma;
+}
+
+/*
+ * Espacio de trabajo para `dotMapa()`: un mapa de bits y un array denso de `dim`
+ * elementos. Se reserva una vez y se reutiliza; después de cada producto dejamos a 0
+ * solo las palabras del mapa que hemos tocado.
+ */
+struct EspacioDisperso {
+    std::vector<uint64_t> bits;
+    std::vector<double> valores;
+
+    explicit EspacioDisperso(size_t dim) : bits((dim + 63) / 64, 0), valores(dim) {}
+};
+
+// Esparce `x` en el espacio de trabajo. Se deshace con `limpia()`.
+void esparce(VectorDisperso const& x, EspacioDisperso& espacio) {
+    for (size_t k = 0; k < x.indices.size(); k++) {
+        uint32_t i = x.indices[k];
+        espacio.bits[i / 64] |= uint64_t(1) << (i % 64);
+        espacio.valores[i] = x.valores[k];
+    }
+}
+
+void limpia(VectorDisperso const& x, EspacioDisperso& espacio) {
+    for (size_t k = 0; k < x.indices.size(); k++)
+        espacio.bits[x.indices[k] / 64] = 0;
+}
+
+// Producto de `y` por el vector que está esparcido en `espacio`.
+double dotEsparcido(EspacioDisperso const& espacio, VectorDisperso const& y) {
+    double suma = 0;
+    for (size_t k = 0; k < y.indices.size(); k++) {
+        uint32_t i = y.indices[k];
+        if ((espacio.bits[i / 64] >> (i % 64)) & 1)
+            suma += espacio.valores[i] * y.valores[k];
+    }
+    return suma;
+}
+
+// Esparcimos el vector con menos no nulos y recorremos el otro.
+double dotMapa(VectorDisperso const& x, VectorDisperso const& y, EspacioDisperso& espacio) {
+    VectorDisperso const& corto = x.indices.size() <= y.indices.size() ? x : y;
+    VectorDisperso const& largo = x.indices.size() <= y.indices.size() ? y : x;
+    esparce(corto, espacio);
+    double suma = dotEsparcido(espacio, largo);
+    limpia(corto, espacio);
+    return suma;
+}
+
+/*
+ * Matriz en formato CSR: los no nulos de la fila `f` son las posiciones
+ * `[inicioFila[f], inicioFila[f + 1])` de `indices` (sus columnas) y `valores`.
+ */
+struct MatrizCSR {
+    size_t filas, columnas;
+    std::vector<size_t> inicioFila;
+    std::vector<uint32_t> indices;
+    std::vector<double> valores;
+};
+
+// Construye la matriz CSR a partir de una densa de `filas x columnas` guardada por filas.
+MatrizCSR comprimeMatriz(const double* a, size_t filas, size_t columnas) {
+    compruebaIndices(columnas);
+    MatrizCSR m;
+    m.filas = filas;
+    m.columnas = columnas;
+    m.inicioFila.push_back(0);
+    for (size_t f = 0; f < filas; f++) {
+        for (size_t c = 0; c < columnas; c++)
+            if (a[f * columnas + c] != 0) {
+                m.indices.push_back(c);
+                m.valores.push_back(a[f * columnas + c]);
+            }
+        m.inicioFila.push_back(m.indices.size());
+    }
+    return m;
+}
+
+/*
+ * `y = A x`. Repartimos las filas entre `hilos` hilos (`0` usa todos los núcleos) en
+ * bloques contiguos con aproximadamente el mismo número de no nulos, que es lo que
+ * determina el trabajo de cada fila.
+ */
+void productoCSR(MatrizCSR const& a, const double* x, double* y, unsigned hilos = 0) {
+    if (hilos == 0)
+        hilos = std::thread::hardware_concurrency();
+    if (hilos == 0)
+        hilos = 1;
+
+    std::vector<size_t> corte(hilos + 1, a.filas);
+    corte[0] = 0;
+    size_t nnz = a.indices.size();
+    size_t fila = 0;
+    for (unsigned t = 1; t < hilos; t++) {
+        while (fila < a.filas && a.inicioFila[fila] < nnz * t / hilos)
+            fila++;
+        corte[t] = fila;
+    }
+
+    auto filas = [&](size_t ini, size_t fin) {
+        for (size_t f = ini; f < fin; f++)
+            y[f] = dotDispersoDenso(a.indices.data() + a.inicioFila[f], a.valores.data() + a.inicioFila[f],
+                                    a.inicioFila[f + 1] - a.inicioFila[f], x);
+    };
+    if (hilos == 1) {
+        filas(0, a.filas);
+        return;
+    }
+
+    std::vector<std::thread> trabajadores;
+    for (unsigned t = 0; t < hilos; t++)
+        trabajadores.push_back(std::thread(filas, corte[t], corte[t + 1]));
+    for (unsigned t = 0; t < hilos; t++)
+        trabajadores[t].join();
+}
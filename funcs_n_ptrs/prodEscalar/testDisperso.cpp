@@ -0,0 +1,108 @@
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#include <chrono>
+
+#include "blas1.cpp"
+#include "disperso.cpp"
+
+#define N_DISPERSO (1 << 22)
+#define N_MATRIZ 2048
+#define DENSIDAD_MATRIZ 0.01
+#define REPETICIONES 5
+
+// Ejecuta `calcula()` varias veces y devuelve el mejor tiempo en ms.
+template <typename C>
+double mide(C calcula) {
+    double mejor = 0;
+    for (int r = 0; r < REPETICIONES; r++) {
+        std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+        volatile double resultado = calcula();
+        (void) resultado;
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        if (r == 0 || ms < mejor)
+            mejor = ms;
+    }
+    return mejor;
+}
+
+// Número «aleatorio» en [0, 1) a partir de `i` y una semilla (ver `integral/montecarlo.cpp`).
+double aleatorio(uint64_t i, uint64_t semilla) {
+    uint64_t z = semilla + (i + 1) * 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return ((z ^ (z >> 31)) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// Rellena `x` con una fracción `densidad` de elementos no nulos.
+void rellenaDisperso(double* x, size_t n, double densidad, uint64_t semilla) {
+    for (size_t i = 0; i < n; i++)
+        x[i] = aleatorio(i, semilla) < densidad ? aleatorio(i, semilla + 1) - 0.5 : 0;
+}
+
+int main() {
+    double* x = reservaAlineada(N_DISPERSO);
+    double* y = reservaAlineada(N_DISPERSO);
+    if (x == nullptr || y == nullptr) {
+        std::cout << "No hay memoria para los vectores de " << N_DISPERSO << " elementos." << std::endl;
+        return 1;
+    }
+
+    /*
+     * Para cada densidad comparamos el producto denso de `blas1.cpp` (con un hilo) con los
+     * dispersos. El denso siempre lee los `n` elementos de ambos vectores; los dispersos
+     * solo leen los no nulos, pero a saltos. A partir de cierta densidad el denso gana.
+     */
+    const double densidades[7] = {0.001, 0.01, 0.05, 0.1, 0.25, 0.5, 1};
+    EspacioDisperso espacio(N_DISPERSO);
+    std::cout << "Producto escalar de vectores de " << N_DISPERSO << " elementos (ms):" << std::endl;
+    std::cout << "\t" << std::setw(10) << "densidad" << std::setw(10) << "denso" << std::setw(16) << "disperso*denso"
+              << std::setw(10) << "mezcla" << std::setw(10) << "mapa" << "  (diferencia máxima)" << std::endl;
+    for (double d : densidades) {
+        rellenaDisperso(x, N_DISPERSO, d, 1);
+        rellenaDisperso(y, N_DISPERSO, d, 2);
+        VectorDisperso xd = comprime(x, N_DISPERSO), yd = comprime(y, N_DISPERSO);
+
+        double denso = dot(x, y, N_DISPERSO, 1);
+        double diferencia = fmax(fabs(dot(xd, y) - denso), fmax(fabs(dotMezcla(xd, yd) - denso),
+                                                               fabs(dotMapa(xd, yd, espacio) - denso)));
+        std::cout << std::setprecision(3) << "\t" << std::setw(10) << d
+                  << std::setw(10) << mide([&]() { return dot(x, y, N_DISPERSO, 1); })
+                  << std::setw(16) << mide([&]() { return dot(xd, y); })
+                  << std::setw(10) << mide([&]() { return dotMezcla(xd, yd); })
+                  << std::setw(10) << mide([&]() { return dotMapa(xd, yd, espacio); })
+                  << "  (" << diferencia << ")" << std::endl;
+    }
+
+    // Matriz dispersa por vector: CSR frente a la matriz densa, fila a fila con `dot()`, ambos con un hilo.
+    double* a = reservaAlineada(N_MATRIZ * N_MATRIZ);
+    double* b = reservaAlineada(N_MATRIZ);
+    double* c = reservaAlineada(N_MATRIZ);
+    if (a == nullptr || b == nullptr || c == nullptr) {
+        std::cout << "No hay memoria para la matriz de " << N_MATRIZ << "x" << N_MATRIZ << " elementos." << std::endl;
+        return 1;
+    }
+    rellenaDisperso(a, N_MATRIZ * N_MATRIZ, DENSIDAD_MATRIZ, 3);
+    for (size_t i = 0; i < N_MATRIZ; i++)
+        x[i] = aleatorio(i, 4);
+    MatrizCSR csr = comprimeMatriz(a, N_MATRIZ, N_MATRIZ);
+
+    productoCSR(csr, x, c);
+    double maxError = 0;
+    for (size_t f = 0; f < N_MATRIZ; f++)
+        maxError = fmax(maxError, fabs(c[f] - dot(a + f * N_MATRIZ, x, N_MATRIZ, 1)));
+    std::cout << std::endl << "Matriz " << N_MATRIZ << "x" << N_MATRIZ << " con densidad " << DENSIDAD_MATRIZ
+              << " (" << csr.indices.size() << " no nulos) por vector: diferencia máxima = " << maxError << std::endl;
+    std::cout << "\tdensa: " << mide([&]() {
+        for (size_t f = 0; f < N_MATRIZ; f++)
+            b[f] = dot(a + f * N_MATRIZ, x, N_MATRIZ, 1);
+        return b[0];
+    }) << " ms; CSR: " << mide([&]() { productoCSR(csr, x, c, 1); return c[0]; }) << " ms" << std::endl;
+
+    liberaAlineada(x);
+    liberaAlineada(y);
+    liberaAlineada(a);
+    liberaAlineada(b);
+    liberaAlineada(c);
+    return 0;
+}
@@ -1,8 +1,28 @@
 #include <iostream>
+#include <cmath>
+#include <chrono>
 
 #include "prodEscalar.cpp"
+#include "blas1.cpp"
 
 #define VECTOR_DIM 2
+#define N_GRANDE (1 << 24)
+#define REPETICIONES 5
+
+// Ejecuta `calcula()` varias veces y devuelve el mejor tiempo en ms.
+template <typename C>
+double mide(C calcula) {
+    double mejor = 0;
+    for (int r = 0; r < REPETICIONES; r++) {
+        std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+        volatile double resultado = calcula();
+        (void) resultado;
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        if (r == 0 || ms < mejor)
+            mejor = ms;
+    }
+    return mejor;
+}
 
 int main() {
     double v[VECTOR_DIM] = {1, 2}, w[VECTOR_DIM] = {3, 4}, rValue, rReference;
@@ -13,5 +33,86 @@ int main() {
     prodescalar(v, w, VECTOR_DIM, rReference);
     std::cout << "Producto escalar de [1, 2] y [3, 4] con paso por referencia = " << rReference << std::endl;
 
+    std::cout << "Producto escalar de [1, 2] y [3, 4] con dot() = " << dot(v, w, VECTOR_DIM) << std::endl;
+
+    // Vectores grandes y alineados: x_i = sin(i), y_i = cos(i).
+    double* x = reservaAlineada(N_GRANDE);
+    double* y = reservaAlineada(N_GRANDE);
+    if (x == nullptr || y == nullptr) {
+        std::cout << "No hay memoria para los vectores de " << N_GRANDE << " elementos." << std::endl;
+        return 1;
+    }
+    for (size_t i = 0; i < N_GRANDE; i++) {
+        x[i] = sin(i);
+        y[i] = cos(i);
+    }
+
+    std::cout << std::endl << "Vectores de " << N_GRANDE << " elementos (SIMD: " << blas1SimdNombre() << "):" << std::endl;
+    std::cout << "\tprodEscalar() = " << prodEscalar(x, y, N_GRANDE) << "; dot() = " << dot(x, y, N_GRANDE) << std::endl;
+    // sum_i sin(i)^2 ~ n / 2.
+    std::cout << "\tnrm2(x)^2 = " << pow(nrm2(x, N_GRANDE), 2) << " (~" << N_GRANDE / 2 << ")" << std::endl;
+    std::cout << "\tasum(x) = " << asum(x, N_GRANDE) << " (~" << 2 / acos(-1) * N_GRANDE << ")" << std::endl;
+
+    // axpy() y scal() se deshacen: y <- y + 2x, y <- y - 2x, y <- 4y, y <- y / 4.
+    axpy(2, x, y, N_GRANDE);
+    axpy(-2, x, y, N_GRANDE);
+    scal(4, y, N_GRANDE);
+    scal(0.25, y, N_GRANDE);
+    double maxError = 0;
+    for (size_t i = 0; i < N_GRANDE; i++)
+        maxError = fmax(maxError, fabs(y[i] - cos(i)));
+    std::cout << "\taxpy() y scal(): error máximo = " << maxError << std::endl;
+
+    // nrm2() no desborda aunque los elementos al cuadrado no quepan en un `double`.
+    double enorme[VECTOR_DIM] = {3e200, 4e200};
+    std::cout << "\tnrm2([3e200, 4e200]) = " << nrm2(enorme, VECTOR_DIM) << std::endl;
+    // Y con un NaN devuelve NaN, no 0.
+    double nans[VECTOR_DIM] = {NAN, NAN};
+    std::cout << "\tnrm2([nan, nan]) = " << nrm2(nans, VECTOR_DIM) << std::endl;
+
+    std::cout << std::endl << "Tiempo del producto escalar (ms):" << std::endl;
+    std::cout << "\tprodEscalar(): " << mide([&]() { return prodEscalar(x, y, N_GRANDE); }) << std::endl;
+    std::cout << "\tdot() con 1 hilo: " << mide([&]() { return dot(x, y, N_GRANDE, 1); }) << std::endl;
+    std::cout << "\tdot() con todos los hilos: " << mide([&]() { return dot(x, y, N_GRANDE); }) << std::endl;
+
+    /*
+     * Producto escalar mal condicionado: en las posiciones 3k y 3k + 2 sumamos y restamos
+     * `1e15 * sin(k)` y en la 3k + 1 sumamos 0.5. El resultado exacto es 0.5 * n / 3, pero
+     * los términos grandes se llevan por delante las cifras de los pequeños.
+     */
+    size_t n3 = N_GRANDE / 3 * 3;
+    for (size_t k = 0; k < n3 / 3; k++) {
+        x[3 * k] = x[3 * k + 2] = 1e15 * sin(k);
+        y[3 * k] = 1;
+        y[3 * k + 2] = -1;
+        x[3 * k + 1] = 1;
+        y[3 * k + 1] = 0.5;
+    }
+    double exacto = 0.5 * (n3 / 3);
+    std::cout << std::endl << "Producto escalar mal condicionado (exacto = " << exacto << "):" << std::endl;
+    std::cout << "\tdoble: error = " << fabs(dot(x, y, n3) - exacto) << ", "
+              << mide([&]() { return dot(x, y, n3, 1); }) << " ms" << std::endl;
+    std::cout << "\tcompensada: error = " << fabs(dot(x, y, n3, DOT_COMPENSADA) - exacto) << ", "
+              << mide([&]() { return dot(x, y, n3, DOT_COMPENSADA, 1); }) << " ms" << std::endl;
+
+    // Los mismos vectores de senos y cosenos en `float`: leemos la mitad de memoria.
+    float* xf = reservaAlineada<float>(N_GRANDE);
+    float* yf = reservaAlineada<float>(N_GRANDE);
+    for (size_t i = 0; i < N_GRANDE; i++) {
+        xf[i] = sin(i);
+        yf[i] = cos(i);
+    }
+    double referencia = dot(xf, yf, N_GRANDE, DOT_COMPENSADA);
+    PrecisionDot precisiones[3] = {DOT_FLOAT, DOT_MIXTA, DOT_COMPENSADA};
+    std::cout << std::endl << "Producto escalar de vectores float (referencia = " << referencia << "):" << std::endl;
+    for (PrecisionDot precision : precisiones)
+        std::cout << "\t" << nombrePrecisionDot(precision) << ": error = "
+                  << fabs(dot(xf, yf, N_GRANDE, precision) - referencia) << ", "
+                  << mide([&]() { return dot(xf, yf, N_GRANDE, precision, 1); }) << " ms" << std::endl;
+
+    liberaAlineada(x);
+    liberaAlineada(y);
+    liberaAlineada(xf);
+    liberaAlineada(yf);
     return 0;
 }
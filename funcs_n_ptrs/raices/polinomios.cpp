@@ -0,0 +1,445 @@
+/*
+ * Polinomios de cualquier grado. Un `Polinomio` guarda sus coeficientes en orden
+ * creciente de grado: `coef[k]` multiplica a `x^k`, así que `{-6, 11, -6, 1}` es
+ * `x^3 - 6x^2 + 11x - 6`. Sobre él ofrecemos:
+ *  - Evaluación por Horner, `((c_n x + c_{n-1}) x + ...) x + c_0`: `n` multiplicaciones
+ *    y sumas, pero cada una depende de la anterior, así que el procesador no puede
+ *    solaparlas. Con el esquema de Estrin agrupamos los coeficientes por parejas
+ *    (`c_0 + c_1 x`, `c_2 + c_3 x`, ...), luego las parejas con `x^2`, luego con `x^4`...
+ *    Hace alguna multiplicación más pero la cadena de dependencias pasa de `n` a
+ *    `log2(n)` operaciones. Para evaluar en muchos puntos `evaluaLote()` usa Horner
+ *    «por columnas», que el compilador vectoriza.
+ *  - Raíces reales de los polinomios de grado 3 y 4 con las fórmulas de Cardano (en
+ *    su forma trigonométrica cuando hay tres raíces reales) y de Ferrari, seguidas de un
+ *    par de pasos de Newton para limpiar el redondeo.
+ *  - Todas las raíces (complejas) de un polinomio de cualquier grado con el método de
+ *    Aberth-Ehrlich: Newton sobre todas las raíces a la vez, donde cada aproximación
+ *    «repele» a las demás para que no converjan a la misma raíz. Converge de manera
+ *    cúbica y cada iteración cuesta `O(n^2)`.
+ *    Más información -> https://en.wikipedia.org/wiki/Aberth_method
+ * Como en `raicesPolGrado2()` las funciones que devuelven raíces reales dejan en `n` el
+ * número de raíces distintas; aquí además las ordenamos de menor a mayor. Las raíces
+ * múltiples están mal condicionadas: un error de redondeo en los coeficientes puede
+ * separarlas o hacerlas complejas. Hay que incluir antes `raicesPolGrado2.cpp`.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <vector>
+
+// Grado máximo para `estrin()`: por encima usamos Horner para no reservar memoria.
+#define MAX_GRADO_ESTRIN 63
+#define BLOQUE_POLINOMIO 256
+#define MAX_ITER_ABERTH 100
+#define PASOS_NEWTON 2
+
+struct Polinomio {
+    std::vector<double> coef;
+
+    Polinomio(std::vector<double> coeficientes = std::vector<double>()) : coef(coeficientes) {}
+
+    // Grado sin contar los coeficientes nulos del final; el polinomio nulo tiene grado -1.
+    int grado() const {
+        int g = coef.size() - 1;
+        while (g >= 0 && coef[g] == 0)
+            g--;
+        return g;
+    }
+};
+
+// Polinomio mónico `(x - r[0]) (x - r[1]) ... (x - r[n-1])`.
+Polinomio desdeRaices(const double* r, int n) {
+    Polinomio p(std::vector<double>(n + 1, 0));
+    p.coef[0] = 1;
+    for (int i = 0; i < n; i++) {
+        for (int k = i + 1; k > 0; k--)
+            p.coef[k] = p.coef[k - 1] - r[i] * p.coef[k];
+        p.coef[0] *= -r[i];
+    }
+    return p;
+}
+
+Polinomio derivada(Polinomio const& p) {
+    Polinomio d;
+    for (size_t k = 1; k < p.coef.size(); k++)
+        d.coef.push_back(k * p.coef[k]);
+    return d;
+}
+
+double horner(Polinomio const& p, double x) {
+    double y = 0;
+    for (int k = p.coef.size() - 1; k >= 0; k--)
+        y = y * x + p.coef[k];
+    return y;
+}
+
+// Horner para `p(x)` y `p'(x)` a la vez: la derivada sigue la misma recurrencia.
+double horner(Polinomio const& p, double x, double& derivada) {
+    double y = 0;
+    derivada = 0;
+    for (int k = p.coef.size() - 1; k >= 0; k--) {
+        derivada = derivada * x + y;
+        y = y * x + p.coef[k];
+    }
+    return y;
+}
+
+double estrin(Polinomio const& p, double x) {
+    int m = p.coef.size();
+    if (m > MAX_GRADO_ESTRIN + 1)
+        return horner(p, x);
+    if (m == 0)
+        return 0;
+
+    // Primer nivel: parejas `c_2k + c_2k+1 x`. Si sobra un coeficiente pasa tal cual.
+    double t[(MAX_GRADO_ESTRIN + 2) / 2];
+    const double* c = p.coef.data();
+    for (int k = 0; k < m / 2; k++)
+        t[k] = c[2 * k] + c[2 * k + 1] * x;
+    if (m % 2)
+        t[m / 2] = c[m - 1];
+    m = (m + 1) / 2;
+
+    // Cada nivel junta parejas del anterior con el cuadrado de la potencia anterior.
+    for (double potencia = x * x; m > 1; potencia *= potencia) {
+        for (int k = 0; k < m / 2; k++)
+            t[k] = t[2 * k] + t[2 * k + 1] * potencia;
+        if (m % 2)
+            t[m / 2] = t[m - 1];
+        m = (m + 1) / 2;
+    }
+    return t[0];
+}
+
+/*
+ * `y[i] = p(x[i])` para `m` puntos. En vez de evaluar un punto detrás de otro damos
+ * cada paso de Horner a un bloque entero de puntos: las iteraciones del bucle interno
+ * son independientes y el compilador las hace con instrucciones vectoriales. El bloque
+ * es un array local para que el compilador sepa que no se solapa con `x` ni con `p`.
+ */
+void evaluaLote(Polinomio const& p, const double* x, double* y, size_t m) {
+    int n = p.coef.size() - 1;
+    if (n < 0) {
+        for (size_t i = 0; i < m; i++)
+            y[i] = 0;
+        return;
+    }
+    size_t ini = 0;
+    for (; ini + BLOQUE_POLINOMIO <= m; ini += BLOQUE_POLINOMIO) {
+        double xb[BLOQUE_POLINOMIO], yb[BLOQUE_POLINOMIO];
+        for (int i = 0; i < BLOQUE_POLINOMIO; i++) {
+            xb[i] = x[ini + i];
+            yb[i] = p.coef[n];
+        }
+        for (int k = n - 1; k >= 0; k--) {
+            double c = p.coef[k];
+            for (int i = 0; i < BLOQUE_POLINOMIO; i++)
+                yb[i] = yb[i] * xb[i] + c;
+        }
+        for (int i = 0; i < BLOQUE_POLINOMIO; i++)
+            y[ini + i] = yb[i];
+    }
+    for (; ini < m; ini++)
+        y[ini] = horner(p, x[ini]);
+}
+
+/*
+ * Un par de pasos de Newton sobre los coeficientes originales. Solo aceptamos un paso
+ * si reduce `|p(x)|`: cerca de una raíz múltiple `p'(x)` es casi 0 y el paso no es fiable.
+ */
+void puleRaices(Polinomio const& p, double* R, int n) {
+    for (int i = 0; i < n; i++)
+        for (int paso = 0; paso < PASOS_NEWTON; paso++) {
+            double d, y = horner(p, R[i], d);
+            if (y == 0 || d == 0)
+                break;
+            double nueva = R[i] - y / d;
+            if (std::fabs(horner(p, nueva)) >= std::fabs(y))
+                break;
+            R[i] = nueva;
+        }
+}
+
+// Ordena las raíces y elimina las repetidas, actualizando `n`.
+void ordenaRaices(double* R, int& n) {
+    std::sort(R, R + n);
+    n = std::unique(R, R + n) - R;
+}
+
+/*
+ * Raíces reales de `a x^3 + b x^2 + c x + d`. Dividimos por `a` y con `x = t - b / (3a)`
+ * llegamos a `t^3 + p t + q = 0`, cuyo discriminante es `D = (q/2)^2 + (p/3)^3`:
+ *  - D > 0: una raíz real, `t = u - p / (3u)` con `u^3 = -q/2 - sign(q) sqrt(D)` (la
+ *    elección del signo evita restar dos números casi iguales, como en grado 2).
+ *  - D < 0: tres raíces reales, `t_k = 2 sqrt(-p/3) cos(phi / 3 - 2 pi k / 3)` con
+ *    `cos(phi) = (3q / 2p) sqrt(-3 / p)`.
+ *  - D = 0: una raíz doble y una simple (o una triple si `p = 0`).
+ */
+void raicesPolGrado3(double a, double b, double c, double d, double* R, int& n) {
+    if (a == 0 && b == 0) {
+        n = c != 0;
+        if (n)
+            R[0] = -d / c;
+        return;
+    }
+    if (a == 0) {
+        raicesPolGrado2(b, c, d, R, n);
+        ordenaRaices(R, n);
+        return;
+    }
+    double A = b / a, B = c / a, C = d / a;
+    double p = B - A * A / 3, q = 2 * A * A * A / 27 - A * B / 3 + C;
+    double D = q * q / 4 + p * p * p / 27, desplazamiento = -A / 3;
+
+    if (D > 0) {
+        double u = std::cbrt(-q / 2 - std::copysign(std::sqrt(D), q));
+        R[0] = u - p / (3 * u);
+        n = 1;
+    } else if (D < 0) {
+        double r = 2 * std::sqrt(-p / 3);
+        double cosPhi = std::max(-1.0, std::min(1.0, 3 * q / (2 * p) * std::sqrt(-3 / p)));
+        double phi = std::acos(cosPhi), pi = std::acos(-1.0);
+        for (int k = 0; k < 3; k++)
+            R[k] = r * std::cos(phi / 3 - 2 * pi * k / 3);
+        n = 3;
+    } else if (p == 0) {
+        R[0] = 0;
+        n = 1;
+    } else {
+        R[0] = 3 * q / p;
+        R[1] = -3 * q / (2 * p);
+        n = 2;
+    }
+    for (int i = 0; i < n; i++)
+        R[i] += desplazamiento;
+    puleRaices(Polinomio({d, c, b, a}), R, n);
+    ordenaRaices(R, n);
+}
+
+/*
+ * Raíces reales de `a x^4 + b x^3 + c x^2 + d x + e` por el método de Ferrari. Con
+ * `x = y - b / (4a)` llegamos a `y^4 + p y^2 + q y + r = 0`. Si `q = 0` es una ecuación
+ * de grado 2 en `y^2`. Si no, buscamos `m > 0` tal que
+ *      (y^2 + p/2 + m)^2 = 2m y^2 - q y + m^2 + m p + p^2/4 - r
+ * tenga a la derecha un cuadrado perfecto, `2m (y - q / 4m)^2`, lo que ocurre cuando `m`
+ * es raíz de la «resolvente» `8m^3 + 8p m^2 + (2p^2 - 8r) m - q^2`. Tomando raíces
+ * cuadradas a ambos lados, con `s = sqrt(2m)`, quedan dos polinomios de grado 2:
+ *      y^2 - s y + p/2 + m + q / 2s     e     y^2 + s y + p/2 + m - q / 2s
+ */
+void raicesPolGrado4(double a, double b, double c, double d, double e, double* R, int& n) {
+    if (a == 0) {
+        raicesPolGrado3(b, c, d, e, R, n);
+        return;
+    }
+    double B = b / a, C = c / a, D = d / a, E = e / a;
+    double p = C - 3 * B * B / 8, q = D - B * C / 2 + B * B * B / 8;
+    double r = E - B * D / 4 + B * B * C / 16 - 3 * B * B * B * B / 256;
+
+    double raices2[2];
+    int n2;
+    n = 0;
+    if (q == 0) {
+        raicesPolGrado2(1, p, r, raices2, n2);
+        for (int i = 0; i < n2; i++)
+            if (raices2[i] >= 0) {
+                R[n++] = std::sqrt(raices2[i]);
+                R[n++] = -std::sqrt(raices2[i]);
+            }
+    } else {
+        // La resolvente vale `-q^2 < 0` en 0 y tiende a infinito: su mayor raíz real es positiva.
+        double resolvente[3];
+        int nr;
+        raicesPolGrado3(8, 8 * p, 2 * p * p - 8 * r, -q * q, resolvente, nr);
+        double m = resolvente[nr - 1], s = std::sqrt(2 * m);
+        for (int signo = -1; signo <= 1; signo += 2) {
+            raicesPolGrado2(1, signo * s, p / 2 + m - signo * q / (2 * s), raices2, n2);
+            for (int i = 0; i < n2; i++)
+                R[n++] = raices2[i];
+        }
+    }
+    for (int i = 0; i < n; i++)
+        R[i] -= B / 4;
+    puleRaices(Polinomio({e, d, c, b, a}), R, n);
+    ordenaRaices(R, n);
+}
+
+// `p(z)` y `p'(z)` por Horner. Hacemos la aritmética compleja a mano: `std::complex` comprueba NaN e infinitos en cada producto.
+void hornerComplejo(Polinomio const& p, std::complex<double> z, std::complex<double>& valor,
+                    std::complex<double>& derivada) {
+    double x = z.real(), y = z.imag(), vr = 0, vi = 0, dr = 0, di = 0;
+    for (int k = p.coef.size() - 1; k >= 0; k--) {
+        double tr = dr * x - di * y + vr;
+        di = dr * y + di * x + vi;
+        dr = tr;
+        tr = vr * x - vi * y + p.coef[k];
+        vi = vr * y + vi * x;
+        vr = tr;
+    }
+    valor = std::complex<double>(vr, vi);
+    derivada = std::complex<double>(dr, di);
+}
+
+inline std::complex<double> inverso(std::complex<double> z) {
+    double modulo2 = z.real() * z.real() + z.imag() * z.imag();
+    return std::complex<double>(z.real() / modulo2, -z.imag() / modulo2);
+}
+
+/*
+ * Las `grado()` raíces complejas de `p` por el método de Aberth-Ehrlich. Partimos de
+ * puntos repartidos en una circunferencia alrededor del centroide de las raíces,
+ * `-c_{n-1} / (n c_n)`, y en cada iteración corregimos cada aproximación con
+ *      w_i = N_i / (1 - N_i sum_{j != i} 1 / (z_i - z_j)),    N_i = p(z_i) / p'(z_i)
+ * usando ya las aproximaciones nuevas de las raíces anteriores (como en Gauss-Seidel).
+ * Paramos cuando todas las correcciones son menores que `tolerancia` relativa. Con
+ * polinomios mal condicionados (e.g. el de Wilkinson) las correcciones se quedan en el
+ * nivel del ruido de redondeo y no bajan de ahí, así que si agotamos las iteraciones aún
+ * damos por buenas las aproximaciones si `|p(z_i)|` no supera la cota del error de
+ * redondeo de Horner, `4 n eps sum |c_k| |z_i|^k`, y devolvemos `MAX_ITER_ABERTH`.
+ * Devuelve el número de iteraciones, o -1 si no ha convergido en `MAX_ITER_ABERTH`.
+ */
+int raicesAberth(Polinomio const& p, std::complex<double>* z, double tolerancia = 1e-14) {
+    int n = p.grado();
+    if (n <= 0)
+        return 0;
+
+    // Las raíces nulas las sacamos directamente y trabajamos con `p / x^ceros`.
+    int ceros = 0;
+    while (p.coef[ceros] == 0)
+        ceros++;
+    for (int i = 0; i < ceros; i++)
+        z[n - 1 - i] = 0;
+    Polinomio q(std::vector<double>(p.coef.begin() + ceros, p.coef.begin() + n + 1));
+    n -= ceros;
+    if (n == 0)
+        return 0;
+
+    // Radio inicial: la media geométrica de los módulos de las raíces respecto al centroide.
+    double centro = -q.coef[n - 1] / (n * q.coef[n]);
+    double radio = std::pow(std::fabs(horner(q, centro) / q.coef[n]), 1.0 / n), pi = std::acos(-1.0);
+    if (radio == 0)
+        radio = 1;
+    for (int i = 0; i < n; i++)
+        z[i] = centro + std::polar(radio, 2 * pi * i / n + 0.4);
+
+    std::vector<bool> convergida(n, false);
+    for (int iter = 1; iter <= MAX_ITER_ABERTH; iter++) {
+        bool terminado = true;
+        for (int i = 0; i < n; i++) {
+            if (convergida[i])
+                continue;
+            std::complex<double> valor, derivada;
+            hornerComplejo(q, z[i], valor, derivada);
+            if (valor == 0.0) {
+                convergida[i] = true;
+                continue;
+            }
+            std::complex<double> newton = valor * inverso(derivada), repulsion = 0;
+            for (int j = 0; j < n; j++)
+                if (j != i)
+                    repulsion += inverso(z[i] - z[j]);
+            std::complex<double> w = newton * inverso(1.0 - newton * repulsion);
+            z[i] -= w;
+            if (std::abs(w) <= tolerancia * std::abs(z[i]))
+                convergida[i] = true;
+            else
+                terminado = false;
+        }
+        if (terminado)
+            return iter;
+    }
+
+    Polinomio modulos(q);
+    for (int k = 0; k <= n; k++)
+        modulos.coef[k] = std::fabs(q.coef[k]);
+    double ruido = 4 * n * std::numeric_limits<double>::epsilon();
+    for (int i = 0; i < n; i++) {
+        std::complex<double> valor, derivada;
+        hornerComplejo(q, z[i], valor, derivada);
+        if (std::abs(valor) > ruido * horner(modulos, std::abs(z[i])))
+            return -1;
+    }
+    return MAX_ITER_ABERTH;
+}
+
+/*
+ * Busca el mayor grupo de `m` aproximaciones sin agrupar, la `i`-ésima y sus `m - 1` más
+ * cercanas, que quepa en un círculo de radio `tolerancia^(1/m)` (relativo) alrededor de
+ * su centro. Las marca como agrupadas, deja el centro en `centro` y devuelve `m`.
+ */
+int agrupaRaices(const std::complex<double>* z, int g, int i, std::vector<bool>& agrupada, double tolerancia,
+                 std::complex<double>& centro) {
+    std::vector<int> cercanas;
+    for (int j = 0; j < g; j++)
+        if (!agrupada[j] && j != i)
+            cercanas.push_back(j);
+    std::sort(cercanas.begin(), cercanas.end(), [&](int a, int b) {
+        return std::abs(z[a] - z[i]) < std::abs(z[b] - z[i]);
+    });
+    cercanas.insert(cercanas.begin(), i);
+
+    int m = cercanas.size();
+    for (centro = z[i]; m > 1; m--) {
+        std::complex<double> suma = 0;
+        for (int k = 0; k < m; k++)
+            suma += z[cercanas[k]];
+        centro = suma / double(m);
+        double radio = std::pow(tolerancia, 1.0 / m) * std::max(1.0, std::abs(centro));
+        int k = 0;
+        while (k < m && std::abs(z[cercanas[k]] - centro) <= radio)
+            k++;
+        if (k == m)
+            break;
+    }
+    if (m == 1)
+        centro = z[i];
+    for (int k = 0; k < m; k++)
+        agrupada[cercanas[k]] = true;
+    return m;
+}
+
+/*
+ * Raíces reales de un polinomio de cualquier grado. Hasta grado 4 usamos las fórmulas
+ * cerradas; a partir de ahí Aberth-Ehrlich. Una raíz de multiplicidad `m` solo se
+ * obtiene con un error del orden de `eps^(1/m)`: una raíz doble real sale como dos
+ * aproximaciones a unos `1e-8` de ella con una parte imaginaria de ese orden. Por eso
+ * agrupamos las aproximaciones cercanas con `agrupaRaices()` y nos quedamos con el
+ * centro de cada grupo. Los centros con una parte imaginaria menor que el radio de su
+ * grupo son las raíces reales, que pulimos con Newton. Como contrapartida, dos raíces
+ * distintas más cercanas que ese radio se cuentan como una sola. `R` ha de tener sitio
+ * para `grado()` raíces. Devuelve las iteraciones de Aberth-Ehrlich (0 con las fórmulas
+ * cerradas), o -1 y `n = 0` si no ha convergido.
+ */
+int raicesReales(Polinomio const& p, double* R, int& n, double tolerancia = 1e-14) {
+    int g = p.grado();
+    std::vector<double> c(p.coef);
+    c.resize(5, 0);
+    n = 0;
+    if (g <= 0)
+        return 0;
+    if (g <= 4) {
+        raicesPolGrado4(c[4], c[3], c[2], c[1], c[0], R, n);
+        return 0;
+    }
+
+    std::vector<std::complex<double> > z(g);
+    int iteraciones = raicesAberth(p, z.data(), tolerancia);
+    if (iteraciones < 0)
+        return -1;
+
+    std::vector<bool> agrupada(g, false);
+    for (int i = 0; i < g; i++) {
+        if (agrupada[i])
+            continue;
+        // El centro de un grupo de `m` aproximaciones tampoco es exacto: toleramos una parte imaginaria del orden de su radio.
+        std::complex<double> centro;
+        int m = agrupaRaices(z.data(), g, i, agrupada, tolerancia, centro);
+        double radio = m == 1 ? 1e3 * tolerancia : std::pow(tolerancia, 1.0 / m);
+        if (std::fabs(centro.imag()) <= radio * std::max(1.0, std::abs(centro)))
+            R[n++] = centro.real();
+    }
+    puleRaices(p, R, n);
+    ordenaRaices(R, n);
+    return iteraciones;
+}
@@ -0,0 +1,174 @@
+/*
+ * Resolución de muchos polinomios de grado 2 a la vez. Los coeficientes se guardan como
+ * «estructura de arrays» (un array con todas las `a`, otro con las `b` y otro con las
+ * `c`) en vez de como un array de estructuras: así podemos cargar 4 u 8 coeficientes
+ * consecutivos en un registro AVX2 o AVX-512 y resolver otros tantos polinomios con cada
+ * instrucción.
+ *
+ * Usamos la misma forma estable que `raicesPolGrado2()` y, en vez de un `if` por caso,
+ * calculamos todo para todos los polinomios y elegimos el resultado con máscaras
+ * («blends»), ya que los distintos polinomios de un registro pueden caer en casos
+ * distintos:
+ *  - delta > 0: dos raíces reales, `r1 = (-b + sqrt(delta)) / (2a)` y `r2` la otra.
+ *  - delta = 0: una raíz doble, `r1 = r2 = -b / (2a)`.
+ *  - delta < 0: dos raíces complejas conjugadas `r1 ± i im` con `r1 = r2 = -b / (2a)` e
+ *    `im = sqrt(-delta) / (2|a|)`. Si no se pide la parte imaginaria dejamos `r1` y
+ *    `r2` a `NaN`, ya que no hay raíces reales.
+ * En `n[i]` guardamos el número de raíces reales distintas, como en `raicesPolGrado2()`.
+ * El orden de `r1` y `r2` se elige con el bit de signo de `b`, igual que `copysign()`,
+ * de modo que `b = -0.0` y `b = +0.0` dan las raíces en el mismo orden.
+ * Por encima de `UMBRAL_RAICES_PARALELO` polinomios repartimos el lote entre varios hilos.
+ * Para compilar hay que pasar `-pthread` a `g++`.
+ */
+
+#include <cmath>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#define UMBRAL_RAICES_PARALELO (1 << 16)
+
+const char* raicesLoteSimdNombre() {
+#if defined(__AVX512F__)
+    return "AVX-512";
+#elif defined(__AVX2__)
+    return "AVX2";
+#else
+    return "ninguno (escalar)";
+#endif
+}
+
+// Versión escalar: resuelve los polinomios `[ini, fin)`. La usamos también para los que no llenan un registro.
+void raicesLoteEscalar(const double* a, const double* b, const double* c, double* r1, double* r2,
+                       double* im, int* n, size_t ini, size_t fin) {
+    for (size_t i = ini; i < fin; i++) {
+        double delta = b[i] * b[i] - 4 * a[i] * c[i], s = std::sqrt(std::fabs(delta));
+        if (delta > 0) {
+            double q = -(b[i] + std::copysign(s, b[i])) / 2;
+            r1[i] = std::signbit(b[i]) ? q / a[i] : c[i] / q;
+            r2[i] = std::signbit(b[i]) ? c[i] / q : q / a[i];
+            n[i] = 2;
+        } else {
+            r1[i] = r2[i] = delta < 0 && im == nullptr ? NAN : -b[i] / (2 * a[i]);
+            n[i] = delta < 0 ? 0 : 1;
+        }
+        if (im)
+            im[i] = delta < 0 ? s / (2 * std::fabs(a[i])) : 0;
+    }
+}
+
+/*
+ * GCC 12 avisa de un `-Wmaybe-uninitialized` falso dentro de sus propias cabeceras de
+ * AVX-512 (ver `integral/integrandosLote.cpp`). Lo silenciamos solo en los núcleos.
+ */
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+void raicesLoteSimd(const double* a, const double* b, const double* c, double* r1, double* r2,
+                    double* im, int* n, size_t ini, size_t fin) {
+    size_t i = ini;
+#if defined(__AVX512F__)
+    const __m512d cero = _mm512_setzero_pd(), mitad = _mm512_set1_pd(0.5), cuatro = _mm512_set1_pd(4);
+    const __m512d nan = _mm512_set1_pd(NAN), uno = _mm512_set1_pd(1), dos = _mm512_set1_pd(2);
+    const __m512i signo = _mm512_set1_epi64(0x8000000000000000LL);
+    for (; i + 8 <= fin; i += 8) {
+        __m512d va = _mm512_loadu_pd(a + i), vb = _mm512_loadu_pd(b + i), vc = _mm512_loadu_pd(c + i);
+        __m512d delta = _mm512_sub_pd(_mm512_mul_pd(vb, vb), _mm512_mul_pd(cuatro, _mm512_mul_pd(va, vc)));
+        __m512d s = _mm512_sqrt_pd(_mm512_abs_pd(delta));
+        __mmask8 positivo = _mm512_cmp_pd_mask(delta, cero, _CMP_GT_OQ);
+        __mmask8 negativo = _mm512_cmp_pd_mask(delta, cero, _CMP_LT_OQ);
+
+        // `copysign(s, b)`: ponemos en `s` el bit de signo de `b`.
+        __m512i bitsSigno = _mm512_and_si512(_mm512_castpd_si512(vb), signo);
+        // Elegimos el orden con el mismo bit (no con `b < 0`) para que `b = -0.0` no las cambie.
+        __mmask8 bNegativo = _mm512_test_epi64_mask(bitsSigno, bitsSigno);
+        __m512d sConSigno = _mm512_castsi512_pd(_mm512_or_si512(_mm512_castpd_si512(s), bitsSigno));
+        __m512d q = _mm512_mul_pd(_mm512_set1_pd(-0.5), _mm512_add_pd(vb, sConSigno));
+        __m512d x1 = _mm512_div_pd(q, va), x2 = _mm512_div_pd(vc, q);
+
+        // Raíz doble o parte real de las complejas: -b / (2a).
+        __m512d doble = _mm512_div_pd(_mm512_mul_pd(vb, _mm512_set1_pd(-0.5)), va);
+        __m512d otro = im ? doble : nan;
+        otro = _mm512_mask_blend_pd(negativo, doble, otro);
+
+        __m512d v1 = _mm512_mask_blend_pd(positivo, otro, _mm512_mask_blend_pd(bNegativo, x2, x1));
+        __m512d v2 = _mm512_mask_blend_pd(positivo, otro, _mm512_mask_blend_pd(bNegativo, x1, x2));
+        _mm512_storeu_pd(r1 + i, v1);
+        _mm512_storeu_pd(r2 + i, v2);
+        if (im)
+            _mm512_storeu_pd(im + i, _mm512_mask_blend_pd(negativo, cero,
+                                                          _mm512_div_pd(_mm512_mul_pd(s, mitad), _mm512_abs_pd(va))));
+
+        // 2 si delta > 0, 0 si delta < 0 y 1 en otro caso.
+        __m512d raices = _mm512_mask_blend_pd(positivo, _mm512_mask_blend_pd(negativo, uno, cero), dos);
+        _mm256_storeu_si256((__m256i*) (n + i), _mm512_cvtpd_epi32(raices));
+    }
+#elif defined(__AVX2__)
+    const __m256d cero = _mm256_setzero_pd(), mitad = _mm256_set1_pd(0.5), cuatro = _mm256_set1_pd(4);
+    const __m256d nan = _mm256_set1_pd(NAN), uno = _mm256_set1_pd(1), dos = _mm256_set1_pd(2);
+    const __m256d signo = _mm256_set1_pd(-0.0);
+    for (; i + 4 <= fin; i += 4) {
+        __m256d va = _mm256_loadu_pd(a + i), vb = _mm256_loadu_pd(b + i), vc = _mm256_loadu_pd(c + i);
+        __m256d delta = _mm256_sub_pd(_mm256_mul_pd(vb, vb), _mm256_mul_pd(cuatro, _mm256_mul_pd(va, vc)));
+        // `|x|` es `x` sin el bit de signo: `andnot` con `-0.0`, que solo tiene ese bit a 1.
+        __m256d s = _mm256_sqrt_pd(_mm256_andnot_pd(signo, delta));
+        __m256d positivo = _mm256_cmp_pd(delta, cero, _CMP_GT_OQ);
+        __m256d negativo = _mm256_cmp_pd(delta, cero, _CMP_LT_OQ);
+        // `blendv` solo mira el bit de signo de la máscara: `vb` nos sirve tal cual y así
+        // `b = -0.0` elige el mismo orden que `copysign()`.
+        __m256d bNegativo = vb;
+
+        __m256d sConSigno = _mm256_or_pd(s, _mm256_and_pd(vb, signo));
+        __m256d q = _mm256_mul_pd(_mm256_set1_pd(-0.5), _mm256_add_pd(vb, sConSigno));
+        __m256d x1 = _mm256_div_pd(q, va), x2 = _mm256_div_pd(vc, q);
+
+        __m256d doble = _mm256_div_pd(_mm256_mul_pd(vb, _mm256_set1_pd(-0.5)), va);
+        __m256d otro = _mm256_blendv_pd(doble, im ? doble : nan, negativo);
+
+        __m256d v1 = _mm256_blendv_pd(otro, _mm256_blendv_pd(x2, x1, bNegativo), positivo);
+        __m256d v2 = _mm256_blendv_pd(otro, _mm256_blendv_pd(x1, x2, bNegativo), positivo);
+        _mm256_storeu_pd(r1 + i, v1);
+        _mm256_storeu_pd(r2 + i, v2);
+        if (im)
+            _mm256_storeu_pd(im + i, _mm256_blendv_pd(cero, _mm256_div_pd(_mm256_mul_pd(s, mitad),
+                                                                          _mm256_andnot_pd(signo, va)), negativo));
+
+        __m256d raices = _mm256_blendv_pd(_mm256_blendv_pd(uno, cero, negativo), dos, positivo);
+        _mm_storeu_si128((__m128i*) (n + i), _mm256_cvtpd_epi32(raices));
+    }
+#endif
+    raicesLoteEscalar(a, b, c, r1, r2, im, n, i, fin);
+}
+
+#pragma GCC diagnostic pop
+
+/*
+ * Resuelve los `total` polinomios `a[i] x^2 + b[i] x + c[i]`. `im` es opcional: si es
+ * `nullptr` no se calculan las raíces complejas. `hilos = 0` usa todos los núcleos.
+ */
+void raicesPolGrado2Lote(const double* a, const double* b, const double* c, size_t total,
+                         double* r1, double* r2, int* n, double* im = nullptr, unsigned hilos = 0) {
+    if (hilos == 0)
+        hilos = std::thread::hardware_concurrency();
+    if (hilos == 0 || total < UMBRAL_RAICES_PARALELO)
+        hilos = 1;
+    if (hilos == 1) {
+        raicesLoteSimd(a, b, c, r1, r2, im, n, 0, total);
+        return;
+    }
+
+    // Trozos múltiplos de 8 polinomios para que solo el último hilo tenga que usar la versión escalar.
+    size_t paso = (total / hilos + 7) / 8 * 8;
+    std::vector<std::thread> trabajadores;
+    for (unsigned t = 0; t < hilos; t++) {
+        size_t ini = t * paso < total ? t * paso : total;
+        size_t fin = t + 1 == hilos || (t + 1) * paso > total ? total : (t + 1) * paso;
+        trabajadores.push_back(std::thread(raicesLoteSimd, a, b, c, r1, r2, im, n, ini, fin));
+    }
+    for (unsigned t = 0; t < hilos; t++)
+        trabajadores[t].join();
+}
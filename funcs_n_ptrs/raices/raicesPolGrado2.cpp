@@ -1,9 +1,19 @@
+/*
+ * `(-b ± sqrt(delta)) / (2a)` resta dos números casi iguales cuando `b^2 >> 4ac` (e.g.
+ * `x^2 + 1e8 x + 1`), con lo que la raíz pequeña pierde casi todas sus cifras. Usamos la
+ * forma estable: con `q = -(b + sign(b) sqrt(delta)) / 2` nunca se restan dos números del
+ * mismo signo y las raíces son `q / a` y `c / q` (ya que su producto es `c / a`).
+ * Además calculamos `sqrt(delta)` una sola vez.
+ */
 void raicesPolGrado2(double a, double b, double c, double* R, int& n) {
     double delta = b * b - 4 * a * c;
     if (delta > 0) {
         n = 2;
-        R[0] = (-b + sqrt(delta)) / (2 * a);
-        R[1] = (-b - sqrt(delta)) / (2 * a);
+        double q = -(b + copysign(sqrt(delta), b)) / 2;
+        // Mantenemos el orden de siempre: `R[0]` es `(-b + sqrt(delta)) / (2a)` y `R[1]` la otra.
+        // Miramos el bit de signo, como `copysign()`: con `b < 0` el caso `b = -0.0` las cambiaría.
+        R[0] = std::signbit(b) ? q / a : c / q;
+        R[1] = std::signbit(b) ? c / q : q / a;
     } else if (delta < 0) {
         n = 0;
     } else {
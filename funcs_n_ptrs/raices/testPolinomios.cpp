@@ -0,0 +1,133 @@
+#include <iostream>
+#include <cmath>
+#include <chrono>
+#include <complex>
+#include <vector>
+
+#include "raicesPolGrado2.cpp"
+#include "polinomios.cpp"
+
+#define N_PUNTOS (1 << 20)
+#define REPETICIONES 5
+
+// Ejecuta `calcula()` varias veces y devuelve el mejor tiempo por punto en ns.
+template <typename F>
+double mide(F calcula) {
+    double mejor = 0;
+    for (int r = 0; r < REPETICIONES; r++) {
+        std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+        volatile double resultado = calcula();
+        (void) resultado;
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() / N_PUNTOS;
+        if (r == 0 || ns < mejor)
+            mejor = ns;
+    }
+    return mejor;
+}
+
+void muestraRaices(const char* nombre, const double* R, int n) {
+    std::cout << "\t" << nombre << ": " << n << " raíces reales;";
+    for (int i = 0; i < n; i++)
+        std::cout << " " << R[i];
+    std::cout << std::endl;
+}
+
+int main() {
+    double R[20];
+    int n;
+
+    std::cout << "Polinomios de grado 3:" << std::endl;
+    raicesPolGrado3(1, -6, 11, -6, R, n);
+    muestraRaices("(x - 1)(x - 2)(x - 3)", R, n);
+    raicesPolGrado3(1, 0, 0, -1, R, n);
+    muestraRaices("x^3 - 1", R, n);
+    raicesPolGrado3(1, 0, -3, 2, R, n);
+    muestraRaices("(x - 1)^2 (x + 2)", R, n);
+
+    std::cout << "Polinomios de grado 4:" << std::endl;
+    raicesPolGrado4(1, -10, 35, -50, 24, R, n);
+    muestraRaices("(x - 1)(x - 2)(x - 3)(x - 4)", R, n);
+    raicesPolGrado4(1, 0, -5, 0, 4, R, n);
+    muestraRaices("(x^2 - 1)(x^2 - 4)", R, n);
+    raicesPolGrado4(1, -1, -1, -1, -2, R, n);
+    muestraRaices("(x^2 + 1)(x + 1)(x - 2)", R, n);
+    raicesPolGrado4(1, 0, 0, 0, 1, R, n);
+    muestraRaices("x^4 + 1", R, n);
+
+    // Polinomio de Wilkinson de grado 10: (x - 1)(x - 2)...(x - 10).
+    double wilkinson[10];
+    for (int i = 0; i < 10; i++)
+        wilkinson[i] = i + 1;
+    Polinomio w = desdeRaices(wilkinson, 10);
+    raicesReales(w, R, n);
+    double maxError = 0;
+    for (int i = 0; i < n; i++)
+        maxError = fmax(maxError, fabs(R[i] - (i + 1)));
+    std::cout << std::endl << "Wilkinson de grado 10: " << n << " raíces reales, error máximo = " << maxError << std::endl;
+
+    // Raíces múltiples: Aberth-Ehrlich las deja como varias aproximaciones cercanas que hay que agrupar.
+    const double conDoble[5] = {1, 1, 3, 4, 5}, conTriple[6] = {2, 2, 2, -1, 5, 6};
+    raicesReales(desdeRaices(conDoble, 5), R, n);
+    muestraRaices("(x - 1)^2 (x - 3)(x - 4)(x - 5)", R, n);
+    raicesReales(desdeRaices(conTriple, 6), R, n);
+    muestraRaices("(x - 2)^3 (x + 1)(x - 5)(x - 6)", R, n);
+
+    // Las raíces de x^20 - 1 son las raíces vigésimas de la unidad.
+    Polinomio unidad(std::vector<double>(21, 0));
+    unidad.coef[0] = -1;
+    unidad.coef[20] = 1;
+    std::complex<double> z[20];
+    int iteraciones = raicesAberth(unidad, z);
+    double maxModulo = 0;
+    for (int i = 0; i < 20; i++)
+        maxModulo = fmax(maxModulo, fabs(std::abs(std::pow(z[i], 20)) - 1));
+    raicesReales(unidad, R, n);
+    std::cout << "x^20 - 1: " << iteraciones << " iteraciones de Aberth-Ehrlich, max |z^20 - 1| = " << maxModulo << ", "
+              << n << " raíces reales (" << R[0] << " y " << R[1] << ")" << std::endl;
+
+    // Evaluación de un polinomio de grado 15 con coeficientes 1 / k! (la serie de exp(x)).
+    Polinomio serie(std::vector<double>(16, 1));
+    for (int k = 1; k < 16; k++)
+        serie.coef[k] = serie.coef[k - 1] / k;
+    std::cout << std::endl << "Serie de exp(x) hasta grado 15 en x = 0.5: Horner = " << horner(serie, 0.5)
+              << ", Estrin = " << estrin(serie, 0.5) << ", exp(0.5) = " << exp(0.5) << std::endl;
+
+    std::vector<double> x(N_PUNTOS), y(N_PUNTOS);
+    for (size_t i = 0; i < N_PUNTOS; i++)
+        x[i] = sin(double(i));
+    // Con muchos puntos independientes el procesador ya solapa varias evaluaciones de Horner.
+    std::cout << "Tiempo por punto independiente (ns):" << std::endl;
+    std::cout << "\thorner(): " << mide([&]() {
+        double suma = 0;
+        for (size_t i = 0; i < N_PUNTOS; i++)
+            suma += horner(serie, x[i]);
+        return suma;
+    }) << std::endl;
+    std::cout << "\testrin(): " << mide([&]() {
+        double suma = 0;
+        for (size_t i = 0; i < N_PUNTOS; i++)
+            suma += estrin(serie, x[i]);
+        return suma;
+    }) << std::endl;
+    std::cout << "\tevaluaLote(): " << mide([&]() {
+        evaluaLote(serie, x.data(), y.data(), N_PUNTOS);
+        return y[N_PUNTOS - 1];
+    }) << std::endl;
+
+    // Si cada punto depende del resultado anterior lo que cuenta es la cadena de dependencias.
+    std::cout << "Tiempo por punto encadenado (ns):" << std::endl;
+    std::cout << "\thorner(): " << mide([&]() {
+        double t = 0;
+        for (size_t i = 0; i < N_PUNTOS; i++)
+            t = horner(serie, x[i] + 1e-20 * t);
+        return t;
+    }) << std::endl;
+    std::cout << "\testrin(): " << mide([&]() {
+        double t = 0;
+        for (size_t i = 0; i < N_PUNTOS; i++)
+            t = estrin(serie, x[i] + 1e-20 * t);
+        return t;
+    }) << std::endl;
+
+    return 0;
+}
@@ -1,11 +1,30 @@
 #include <iostream>
 #include <cmath>
+#include <chrono>
+#include <vector>
 
 #include "raicesPolGrado2.cpp"
+#include "raicesLote.cpp"
 
 #define A 2
 #define B 4
 #define C 1
+#define N_LOTE (1 << 22)
+#define REPETICIONES 5
+
+// Ejecuta `calcula()` varias veces y devuelve el mejor tiempo por polinomio en ns.
+template <typename F>
+double mide(F calcula) {
+    double mejor = 0;
+    for (int r = 0; r < REPETICIONES; r++) {
+        std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+        calcula();
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() / N_LOTE;
+        if (r == 0 || ns < mejor)
+            mejor = ns;
+    }
+    return mejor;
+}
 
 int main() {
     int nRoots;
@@ -17,5 +36,62 @@ int main() {
     for(int i = 0; i < nRoots; i++)
         std::cout << "\tRaíz " << i + 1 << ": " << roots[i] << std::endl;
 
+    // Con la fórmula de siempre la raíz pequeña de x^2 + 1e8 x + 1 (~ -1e-8) sale con un error del 25%.
+    raicesPolGrado2(1, 1e8, 1, roots, nRoots);
+    double ingenua = (-1e8 + sqrt(1e16 - 4)) / 2;
+    std::cout << "Raíz pequeña de x^2 + 1e8 x + 1: " << roots[0] << " (con (-b + sqrt(delta)) / 2a: " << ingenua << ")"
+              << std::endl;
+
+    // Un lote con los tres casos: delta > 0, delta = 0 y delta < 0.
+    double a[3] = {1, 1, 1}, b[3] = {-3, 2, 2}, c[3] = {2, 1, 5}, r1[3], r2[3], im[3];
+    int n[3];
+    raicesPolGrado2Lote(a, b, c, 3, r1, r2, n, im);
+    std::cout << std::endl << "Lote de 3 polinomios (SIMD: " << raicesLoteSimdNombre() << "):" << std::endl;
+    for (int i = 0; i < 3; i++) {
+        std::cout << "\t" << a[i] << " x^2 + " << b[i] << " x + " << c[i] << ": " << n[i] << " raíces reales; ";
+        if (n[i] == 0)
+            std::cout << r1[i] << " ± " << im[i] << "i" << std::endl;
+        else
+            std::cout << r1[i] << ", " << r2[i] << std::endl;
+    }
+
+    // Coeficientes en [-1, 1) a partir de senos, con lo que hay de todos los casos.
+    std::vector<double> va(N_LOTE), vb(N_LOTE), vc(N_LOTE), v1(N_LOTE), v2(N_LOTE), vim(N_LOTE);
+    std::vector<int> vn(N_LOTE);
+    for (size_t i = 0; i < N_LOTE; i++) {
+        va[i] = sin(3.0 * i + 1);
+        vb[i] = sin(5.0 * i + 2);
+        vc[i] = sin(7.0 * i + 3);
+    }
+
+    raicesPolGrado2Lote(va.data(), vb.data(), vc.data(), N_LOTE, v1.data(), v2.data(), vn.data());
+    // Con `-march=native` el compilador puede usar FMA en `raicesPolGrado2()`, así que comparamos con una tolerancia.
+    long distintas = 0;
+    double maxDiferencia = 0;
+    for (size_t i = 0; i < N_LOTE; i++) {
+        raicesPolGrado2(va[i], vb[i], vc[i], roots, nRoots);
+        if (nRoots != vn[i])
+            distintas++;
+        for (int k = 0; k < nRoots; k++)
+            maxDiferencia = fmax(maxDiferencia, fabs(roots[k] - (k == 0 ? v1[i] : v2[i])) / fabs(roots[k]));
+    }
+    std::cout << std::endl << "Lote de " << N_LOTE << " polinomios frente a raicesPolGrado2(): " << distintas
+              << " con distinto número de raíces, diferencia relativa máxima = " << maxDiferencia << std::endl;
+
+    std::cout << "Tiempo por polinomio (ns):" << std::endl;
+    std::cout << "\traicesPolGrado2(): " << mide([&]() {
+        for (size_t i = 0; i < N_LOTE; i++) {
+            raicesPolGrado2(va[i], vb[i], vc[i], roots, nRoots);
+            v1[i] = roots[0];
+            vn[i] = nRoots;
+        }
+    }) << std::endl;
+    std::cout << "\tlote con 1 hilo: " << mide([&]() {
+        raicesPolGrado2Lote(va.data(), vb.data(), vc.data(), N_LOTE, v1.data(), v2.data(), vn.data(), nullptr, 1);
+    }) << std::endl;
+    std::cout << "\tlote con raíces complejas y todos los hilos: " << mide([&]() {
+        raicesPolGrado2Lote(va.data(), vb.data(), vc.data(), N_LOTE, v1.data(), v2.data(), vn.data(), vim.data());
+    }) << std::endl;
+
     return 0;
 }
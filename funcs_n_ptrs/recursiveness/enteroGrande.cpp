@@ -0,0 +1,318 @@
+/*
+ * Enteros sin signo de precisión arbitraria. Guardamos el número en base `10^9` como un
+ * vector de «cifras» (`limbs`) de 32 bits, de la menos a la más significativa:
+ *      1234567890123 = 1234 * 10^9 + 567890123  ->  {567890123, 1234}
+ * Con base `10^9` pasar a decimal para imprimir es inmediato y el producto de dos
+ * cifras (< 10^18) cabe en un `uint64_t`.
+ * El producto usa el algoritmo de la escuela (`O(n^2)`) para números pequeños y el de
+ * Karatsuba por encima de `UMBRAL_KARATSUBA` cifras: partimos cada factor en dos
+ * mitades, `a = a1 B^m + a0`, y con
+ *      a b = a1 b1 B^2m + ((a0 + a1)(b0 + b1) - a0 b0 - a1 b1) B^m + a0 b0
+ * nos basta con 3 productos de la mitad de tamaño en vez de 4, i.e. `O(n^1.585)`.
+ * Por encima de `UMBRAL_FFT` cifras el producto es una convolución de las cifras y la
+ * calculamos con la transformada rápida de Fourier en `O(n log n)`. Para que el
+ * redondeo de los `double` no estropee el resultado partimos cada limb en 3 cifras en
+ * base 1000, y si la transformada tuviera que ser mayor que `MAX_FFT` volvemos a partir
+ * los factores con Karatsuba.
+ * Más información -> https://en.wikipedia.org/wiki/Karatsuba_algorithm y
+ * https://en.wikipedia.org/wiki/Multiplication_algorithm#Fourier_transform_methods
+ */
+
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#define BASE_ENTERO_GRANDE 1000000000u
+#define CIFRAS_POR_LIMB 9
+#define UMBRAL_KARATSUBA 48
+#define FILAS_SIN_ACARREO 16
+#define UMBRAL_FFT 768
+#define MAX_FFT (1 << 22)
+
+typedef std::vector<uint32_t> Limbs;
+
+// Quita los limbs nulos de la parte alta. El cero es el vector vacío.
+void normaliza(Limbs& a) {
+    while (!a.empty() && a.back() == 0)
+        a.pop_back();
+}
+
+// `r += a`, con `nr >= na` limbs en `r`. Para sumar `a * B^k` basta con pasar `r + k`.
+void sumaDesplazada(uint32_t* r, size_t nr, const uint32_t* a, size_t na) {
+    uint32_t acarreo = 0;
+    size_t i = 0;
+    for (; i < na; i++) {
+        uint32_t s = r[i] + a[i] + acarreo;
+        acarreo = s >= BASE_ENTERO_GRANDE;
+        r[i] = acarreo ? s - BASE_ENTERO_GRANDE : s;
+    }
+    for (; acarreo && i < nr; i++) {
+        r[i] += 1;
+        acarreo = r[i] == BASE_ENTERO_GRANDE;
+        if (acarreo)
+            r[i] = 0;
+    }
+}
+
+// `r -= a`, con `r >= a`.
+void restaLimbs(uint32_t* r, size_t nr, const uint32_t* a, size_t na) {
+    uint32_t prestamo = 0;
+    size_t i = 0;
+    for (; i < na; i++) {
+        uint32_t s = a[i] + prestamo;
+        prestamo = r[i] < s;
+        r[i] = prestamo ? r[i] + BASE_ENTERO_GRANDE - s : r[i] - s;
+    }
+    for (; prestamo && i < nr; i++) {
+        prestamo = r[i] == 0;
+        r[i] = prestamo ? BASE_ENTERO_GRANDE - 1 : r[i] - 1;
+    }
+}
+
+/*
+ * Algoritmo de la escuela: `r[0, na + nb) = a * b`. Acumulamos los
+ * productos parciales (< 10^18) en columnas de 64 bits y solo propagamos los acarreos
+ * cada `FILAS_SIN_ACARREO` filas: así el bucle interno es una multiplicación y una suma
+ * independientes que el compilador vectoriza, sin la división por la base.
+ */
+void multiplicaEscuela(const uint32_t* a, size_t na, const uint32_t* b, size_t nb, uint32_t* r) {
+    std::vector<uint64_t> columnas(na + nb, 0);
+    for (size_t i0 = 0; i0 < na; i0 += FILAS_SIN_ACARREO) {
+        size_t i1 = i0 + FILAS_SIN_ACARREO < na ? i0 + FILAS_SIN_ACARREO : na;
+        for (size_t i = i0; i < i1; i++) {
+            uint64_t ai = a[i];
+            uint64_t* c = columnas.data() + i;
+            for (size_t j = 0; j < nb; j++)
+                c[j] += ai * b[j];
+        }
+        // Dejamos cada columna por debajo de la base pasando el resto a la siguiente.
+        uint64_t acarreo = 0;
+        for (size_t k = i0; k < i1 + nb; k++) {
+            uint64_t t = columnas[k] + acarreo;
+            acarreo = t / BASE_ENTERO_GRANDE;
+            columnas[k] = t - acarreo * BASE_ENTERO_GRANDE;
+        }
+    }
+    for (size_t k = 0; k < na + nb; k++)
+        r[k] = columnas[k];
+}
+
+void multiplicaLimbs(const uint32_t* a, size_t na, const uint32_t* b, size_t nb, uint32_t* r);
+
+// Transformada de Fourier iterativa de `f` (de tamaño potencia de 2), o su inversa sin dividir por el tamaño.
+void fft(std::vector<std::complex<double> >& f, bool inversa) {
+    size_t n = f.size();
+    for (size_t i = 1, j = 0; i < n; i++) {
+        size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1)
+            j ^= bit;
+        j ^= bit;
+        if (i < j)
+            std::swap(f[i], f[j]);
+    }
+
+    // Las raíces de la unidad las calculamos una a una con `cos` y `sin`: con productos sucesivos se acumula el error.
+    double pi = std::acos(-1.0), signo = inversa ? 1 : -1;
+    std::vector<double> re(n / 2), im(n / 2);
+    for (size_t k = 0; k < n / 2; k++) {
+        re[k] = std::cos(2 * pi * k / n);
+        im[k] = signo * std::sin(2 * pi * k / n);
+    }
+    for (size_t largo = 2; largo <= n; largo *= 2) {
+        size_t paso = n / largo;
+        for (size_t ini = 0; ini < n; ini += largo)
+            for (size_t k = 0; k < largo / 2; k++) {
+                std::complex<double>& u = f[ini + k];
+                std::complex<double>& v = f[ini + k + largo / 2];
+                double wr = re[k * paso], wi = im[k * paso];
+                double tr = v.real() * wr - v.imag() * wi, ti = v.real() * wi + v.imag() * wr;
+                v = std::complex<double>(u.real() - tr, u.imag() - ti);
+                u = std::complex<double>(u.real() + tr, u.imag() + ti);
+            }
+    }
+}
+
+/*
+ * `r[0, na + nb) = a * b` con la FFT. Metemos `a` en la parte real y `b` en la
+ * imaginaria: como `(a + i b)^2 = a^2 - b^2 + 2i ab`, la parte imaginaria de la
+ * convolución de `a + i b` consigo misma es el doble de la de `a` y `b`, y nos ahorramos
+ * una transformada.
+ */
+void multiplicaFFT(const uint32_t* a, size_t na, const uint32_t* b, size_t nb, uint32_t* r) {
+    size_t n = 1;
+    while (n < 3 * (na + nb))
+        n *= 2;
+    const uint32_t potencia[3] = {1, 1000, 1000000};
+    std::vector<std::complex<double> > f(n);
+    for (size_t i = 0; i < 3 * na || i < 3 * nb; i++) {
+        double ai = i < 3 * na ? a[i / 3] / potencia[i % 3] % 1000 : 0;
+        double bi = i < 3 * nb ? b[i / 3] / potencia[i % 3] % 1000 : 0;
+        f[i] = std::complex<double>(ai, bi);
+    }
+    fft(f, false);
+    for (size_t i = 0; i < n; i++)
+        f[i] *= f[i];
+    fft(f, true);
+
+    // Redondeamos cada cifra de la convolución y propagamos los acarreos en base 1000.
+    uint64_t acarreo = 0;
+    for (size_t k = 0; k < na + nb; k++) {
+        uint32_t limb = 0;
+        for (int d = 0; d < 3; d++) {
+            uint64_t t = acarreo + (uint64_t) std::llround(f[3 * k + d].imag() / (2.0 * n));
+            acarreo = t / 1000;
+            limb += t % 1000 * potencia[d];
+        }
+        r[k] = limb;
+    }
+}
+
+/*
+ * `r[0, na + nb) = a * b` con Karatsuba, con `r` a 0. Si un factor es mucho más corto
+ * que el otro no merece la pena partirlo: multiplicamos el largo por trozos.
+ */
+void multiplicaKaratsuba(const uint32_t* a, size_t na, const uint32_t* b, size_t nb, uint32_t* r) {
+    if (na < nb) {
+        multiplicaKaratsuba(b, nb, a, na, r);
+        return;
+    }
+    size_t m = (na + 1) / 2;
+    if (nb <= m) {
+        // `a` es al menos el doble de largo que `b`: `a0 b + a1 b B^m`.
+        Limbs parcial(na - m + nb);
+        multiplicaLimbs(a, m, b, nb, r);
+        multiplicaLimbs(a + m, na - m, b, nb, parcial.data());
+        sumaDesplazada(r + m, na + nb - m, parcial.data(), parcial.size());
+        return;
+    }
+
+    // Sumas de las mitades, que pueden tener un limb más.
+    Limbs sa(a, a + m), sb(b, b + m);
+    sa.push_back(0);
+    sb.push_back(0);
+    sumaDesplazada(sa.data(), sa.size(), a + m, na - m);
+    sumaDesplazada(sb.data(), sb.size(), b + m, nb - m);
+
+    Limbs z1(sa.size() + sb.size());
+    multiplicaLimbs(a, m, b, m, r);
+    multiplicaLimbs(a + m, na - m, b + m, nb - m, r + 2 * m);
+    multiplicaLimbs(sa.data(), sa.size(), sb.data(), sb.size(), z1.data());
+
+    // z1 = (a0 + a1)(b0 + b1) - a0 b0 - a1 b1, que ya está en `r`.
+    restaLimbs(z1.data(), z1.size(), r, 2 * m);
+    restaLimbs(z1.data(), z1.size(), r + 2 * m, na + nb - 2 * m);
+    size_t nz = z1.size();
+    while (nz > 0 && z1[nz - 1] == 0)
+        nz--;
+    sumaDesplazada(r + m, na + nb - m, z1.data(), nz);
+}
+
+// Elige el algoritmo según el tamaño del factor más corto. `r` ha de estar a 0.
+void multiplicaLimbs(const uint32_t* a, size_t na, const uint32_t* b, size_t nb, uint32_t* r) {
+    size_t corto = na < nb ? na : nb;
+    if (corto < UMBRAL_KARATSUBA)
+        multiplicaEscuela(a, na, b, nb, r);
+    else if (corto < UMBRAL_FFT || 3 * (na + nb) > MAX_FFT)
+        multiplicaKaratsuba(a, na, b, nb, r);
+    else
+        multiplicaFFT(a, na, b, nb, r);
+}
+
+struct EnteroGrande {
+    Limbs limbs;
+
+    EnteroGrande(uint64_t valor = 0) {
+        for (; valor; valor /= BASE_ENTERO_GRANDE)
+            limbs.push_back(valor % BASE_ENTERO_GRANDE);
+    }
+
+    bool esCero() const { return limbs.empty(); }
+
+    // Número de cifras decimales.
+    size_t cifras() const {
+        if (limbs.empty())
+            return 1;
+        size_t n = (limbs.size() - 1) * CIFRAS_POR_LIMB;
+        for (uint32_t alto = limbs.back(); alto; alto /= 10)
+            n++;
+        return n;
+    }
+
+    std::string aCadena() const {
+        if (limbs.empty())
+            return "0";
+        std::string s = std::to_string(limbs.back());
+        for (size_t i = limbs.size() - 1; i-- > 0;) {
+            std::string limb = std::to_string(limbs[i]);
+            s.append(CIFRAS_POR_LIMB - limb.size(), '0');
+            s += limb;
+        }
+        return s;
+    }
+};
+
+// -1, 0 o 1 según `a` sea menor, igual o mayor que `b`.
+int compara(EnteroGrande const& a, EnteroGrande const& b) {
+    if (a.limbs.size() != b.limbs.size())
+        return a.limbs.size() < b.limbs.size() ? -1 : 1;
+    for (size_t i = a.limbs.size(); i-- > 0;)
+        if (a.limbs[i] != b.limbs[i])
+            return a.limbs[i] < b.limbs[i] ? -1 : 1;
+    return 0;
+}
+
+inline bool operator==(EnteroGrande const& a, EnteroGrande const& b) { return compara(a, b) == 0; }
+inline bool operator!=(EnteroGrande const& a, EnteroGrande const& b) { return compara(a, b) != 0; }
+inline bool operator<(EnteroGrande const& a, EnteroGrande const& b) { return compara(a, b) < 0; }
+
+EnteroGrande operator+(EnteroGrande const& a, EnteroGrande const& b) {
+    EnteroGrande const& largo = a.limbs.size() >= b.limbs.size() ? a : b;
+    EnteroGrande const& corto = a.limbs.size() >= b.limbs.size() ? b : a;
+    EnteroGrande r = largo;
+    r.limbs.push_back(0);
+    sumaDesplazada(r.limbs.data(), r.limbs.size(), corto.limbs.data(), corto.limbs.size());
+    normaliza(r.limbs);
+    return r;
+}
+
+// `a - b`, con `a >= b`: son enteros sin signo.
+EnteroGrande operator-(EnteroGrande const& a, EnteroGrande const& b) {
+    EnteroGrande r = a;
+    restaLimbs(r.limbs.data(), r.limbs.size(), b.limbs.data(), b.limbs.size());
+    normaliza(r.limbs);
+    return r;
+}
+
+EnteroGrande operator*(EnteroGrande const& a, EnteroGrande const& b) {
+    EnteroGrande r;
+    if (a.esCero() || b.esCero())
+        return r;
+    r.limbs.assign(a.limbs.size() + b.limbs.size(), 0);
+    multiplicaLimbs(a.limbs.data(), a.limbs.size(), b.limbs.data(), b.limbs.size(), r.limbs.data());
+    normaliza(r.limbs);
+    return r;
+}
+
+// `a *= v` para un `v` menor que la base, sin pasar por el producto general.
+void multiplicaPequeno(EnteroGrande& a, uint32_t v) {
+    uint64_t acarreo = 0;
+    for (size_t i = 0; i < a.limbs.size(); i++) {
+        uint64_t t = (uint64_t) a.limbs[i] * v + acarreo;
+        acarreo = t / BASE_ENTERO_GRANDE;
+        a.limbs[i] = t - acarreo * BASE_ENTERO_GRANDE;
+    }
+    if (acarreo)
+        a.limbs.push_back(acarreo);
+    normaliza(a.limbs);
+}
+
+inline EnteroGrande& operator+=(EnteroGrande& a, EnteroGrande const& b) { return a = a + b; }
+inline EnteroGrande& operator-=(EnteroGrande& a, EnteroGrande const& b) { return a = a - b; }
+inline EnteroGrande& operator*=(EnteroGrande& a, EnteroGrande const& b) { return a = a * b; }
+
+std::ostream& operator<<(std::ostream& os, EnteroGrande const& a) {
+    return os << a.aCadena();
+}
@@ -1,14 +1,49 @@
 #include <iostream>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+
+#include "enteroGrande.cpp"
+#include "factorialGrande.cpp"
+#include "tablas.cpp"
+
+// 10^7! tiene unos 65 millones de cifras y ya tarda más de un minuto en calcularse y mostrarse.
+#define MAX_FACTORIAL 10000000
 
 long int factorialRecursive(long int);
 long int factorialIterative(long int);
+void benchmark();
+
+int main(int argc, char** argv) {
+    if (argc == 2 && std::string(argv[1]) == "--benchmark") {
+        benchmark();
+        return 0;
+    }
 
-int main() {
     long int n = 0;
     std::cout << "Number to compute the factorial for: ";
     std::cin >> n;
 
-    std::cout << n << "! = " << factorialRecursive(n) << " == " << factorialIterative(n) << std::endl;
+    if (n < 0 || n > MAX_FACTORIAL) {
+        std::cout << "The number MUST be in [0, " << MAX_FACTORIAL << "]: larger factorials take too much time and memory...\n";
+        return -1;
+    }
+
+    // Hasta 20! cabe en 64 bits y está en la tabla calculada al compilar.
+    try {
+        uint64_t tabla = factorialTabla(n);
+        std::cout << n << "! = " << tabla << " == " << factorialRecursive(n) << " == " << factorialIterative(n)
+                  << std::endl;
+        return 0;
+    } catch (std::out_of_range const& ex) {
+        std::cout << ex.what() << ", computing it exactly..." << std::endl;
+    }
+
+    EnteroGrande fact = factorialPrimeSwing(n);
+    if (fact.cifras() <= 100)
+        std::cout << n << "! = " << fact << std::endl;
+    else
+        std::cout << n << "! has " << fact.cifras() << " digits: " << fact.aCadena().substr(0, 20) << "..." << std::endl;
 
     return 0;
 }
@@ -28,3 +63,33 @@ long int factorialIterative(long int n) {
 
     return fact;
 }
+
+// Compara el producto factor a factor con el árbol de productos y con el «prime swing».
+void benchmark() {
+    typedef std::chrono::steady_clock reloj;
+    std::cout << "n\tdigits\t\tone by one (ms)\tbinary splitting (ms)\tprime swing (ms)" << std::endl;
+    for (uint32_t n = 1000; n <= 100000; n *= 10) {
+        reloj::time_point t0 = reloj::now();
+        // El producto factor a factor es cuadrático: para n = 10^5 ya tarda segundos.
+        EnteroGrande uno(1);
+        if (n <= 10000)
+            for (uint32_t k = 2; k <= n; k++)
+                multiplicaPequeno(uno, k);
+        reloj::time_point t1 = reloj::now();
+        EnteroGrande binario = factorialBinario(n);
+        reloj::time_point t2 = reloj::now();
+        EnteroGrande swing = factorialPrimeSwing(n);
+        reloj::time_point t3 = reloj::now();
+
+        std::cout << n << "\t" << swing.cifras() << "\t\t";
+        if (n <= 10000)
+            std::cout << std::chrono::duration<double, std::milli>(t1 - t0).count();
+        else
+            std::cout << "-";
+        std::cout << "\t\t" << std::chrono::duration<double, std::milli>(t2 - t1).count() << "\t\t\t"
+                  << std::chrono::duration<double, std::milli>(t3 - t2).count();
+        if (binario != swing || (n <= 10000 && uno != swing))
+            std::cout << "\tMISMATCH";
+        std::cout << std::endl;
+    }
+}
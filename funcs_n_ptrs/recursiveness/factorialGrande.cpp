@@ -0,0 +1,103 @@
+/*
+ * Factoriales exactos de cualquier tamaño con los `EnteroGrande` de `enteroGrande.cpp`,
+ * que hay que incluir antes. Multiplicar `1 * 2 * ... * n` de uno en uno hace `n`
+ * productos de un número enorme por uno pequeño: `O(n^2)` en total. Lo que conviene es
+ * que los productos grandes sean entre números de tamaño parecido, que es donde
+ * Karatsuba y la FFT ganan:
+ *  - «Binary splitting»: `producto(a, b) = producto(a, m) * producto(m, b)`, i.e. un
+ *    árbol de productos. Las hojas juntan factores pequeños en un único limb.
+ *  - «Prime swing» (Luschny): `n! = ((n/2)!)^2 * swing(n)`, donde `swing(n) =
+ *    n! / ((n/2)!)^2` se calcula a partir de su factorización: el primo `p` aparece con
+ *    exponente `sum_k (floor(n / p^k) mod 2)`. Así casi todo el trabajo son cuadrados y
+ *    el producto de los factores de `swing(n)` (con el mismo árbol).
+ *    Más información -> http://www.luschny.de/math/factorial/FastFactorialFunctions.htm
+ * Hasta `MAX_FACTORIAL_64` el resultado cabe en 64 bits y usamos `factorialIterative()`.
+ */
+
+#include <cstdint>
+#include <vector>
+
+#define MAX_FACTORIAL_64 20
+
+long int factorialIterative(long int);
+
+/*
+ * Producto de `factores[ini, fin)` con un árbol binario. Para no tener hojas de un
+ * solo limb multiplicamos primero los factores pequeños entre sí mientras el
+ * resultado quepa en un limb.
+ */
+EnteroGrande productoArbol(std::vector<uint32_t> const& factores, size_t ini, size_t fin) {
+    if (fin - ini <= 1)
+        return EnteroGrande(ini < fin ? factores[ini] : 1);
+    size_t medio = ini + (fin - ini) / 2;
+    return productoArbol(factores, ini, medio) * productoArbol(factores, medio, fin);
+}
+
+// Junta en cada elemento tantos factores consecutivos como quepan en un limb (< 10^9).
+std::vector<uint32_t> agrupaFactores(std::vector<uint32_t> const& factores) {
+    std::vector<uint32_t> grupos;
+    uint64_t actual = 1;
+    for (size_t i = 0; i < factores.size(); i++) {
+        if (actual * factores[i] >= BASE_ENTERO_GRANDE) {
+            grupos.push_back(actual);
+            actual = 1;
+        }
+        actual *= factores[i];
+    }
+    if (actual > 1 || grupos.empty())
+        grupos.push_back(actual);
+    return grupos;
+}
+
+// `(a, b]` multiplicados con el árbol. Requiere `b < 10^9`.
+EnteroGrande productoRango(uint32_t a, uint32_t b) {
+    std::vector<uint32_t> factores;
+    for (uint32_t k = a + 1; k <= b; k++)
+        factores.push_back(k);
+    std::vector<uint32_t> grupos = agrupaFactores(factores);
+    return productoArbol(grupos, 0, grupos.size());
+}
+
+EnteroGrande factorialBinario(uint32_t n) {
+    if (n <= MAX_FACTORIAL_64)
+        return EnteroGrande(factorialIterative(n));
+    return productoRango(1, n);
+}
+
+// Criba de Eratóstenes: los primos hasta `n`.
+std::vector<uint32_t> primosHasta(uint32_t n) {
+    std::vector<bool> compuesto(n + 1, false);
+    std::vector<uint32_t> primos;
+    for (uint64_t p = 2; p <= n; p++) {
+        if (compuesto[p])
+            continue;
+        primos.push_back(p);
+        for (uint64_t m = p * p; m <= n; m += p)
+            compuesto[m] = true;
+    }
+    return primos;
+}
+
+EnteroGrande swing(uint32_t n, std::vector<uint32_t> const& primos) {
+    std::vector<uint32_t> factores;
+    for (size_t i = 0; i < primos.size() && primos[i] <= n; i++) {
+        uint32_t p = primos[i];
+        // Los primos mayores que n/2 aparecen una vez; los de (n/3, n/2] ninguna.
+        for (uint32_t q = n / p; q > 0; q /= p)
+            if (q & 1)
+                factores.push_back(p);
+    }
+    std::vector<uint32_t> grupos = agrupaFactores(factores);
+    return productoArbol(grupos, 0, grupos.size());
+}
+
+EnteroGrande factorialPrimeSwing(uint32_t n, std::vector<uint32_t> const& primos) {
+    if (n <= MAX_FACTORIAL_64)
+        return EnteroGrande(factorialIterative(n));
+    EnteroGrande mitad = factorialPrimeSwing(n / 2, primos);
+    return mitad * mitad * swing(n, primos);
+}
+
+EnteroGrande factorialPrimeSwing(uint32_t n) {
+    return factorialPrimeSwing(n, primosHasta(n));
+}
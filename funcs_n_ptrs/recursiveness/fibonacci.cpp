@@ -1,20 +1,47 @@
 #include <iostream>
+#include <chrono>
+#include <string>
+
+#include "enteroGrande.cpp"
+#include "fibonacciRapido.cpp"
+#include "tablas.cpp"
+
+// F(10^8) tiene unos 21 millones de cifras y ya tarda unos segundos; F(3 * 10^8) pasa del minuto y medio.
+#define MAX_FIBONACCI 100000000
 
 int fibonacci(int);
+void benchmark();
+
+int main(int argc, char** argv) {
+    if (argc == 2 && std::string(argv[1]) == "--benchmark") {
+        benchmark();
+        return 0;
+    }
 
-int main() {
-    int choice = 0;
+    MemoFibonacci memo;
+    long choice = 0;
 
     while (choice != -1) {
-        std::cout << "Fibonacci sequence index [0, +inf): ";
+        std::cout << "Fibonacci sequence index [0, " << MAX_FIBONACCI << "]: ";
         std::cin >> choice;
         if (choice == -1)
             break;
-        else if (choice < 0 ) {
-            std::cout << "The chosen index MUST be at least 0...\n";
+        else if (choice < 0 || choice > MAX_FIBONACCI) {
+            std::cout << "The chosen index MUST be in [0, " << MAX_FIBONACCI
+                      << "]: larger ones take too much time and memory...\n";
             return -1;
         }
-        std::cout << "Fib(" << choice << ") = " << fibonacci(choice) << std::endl;
+        // Lo que cabe en 64 bits está en la tabla calculada al compilar.
+        if (choice <= MAX_FIBONACCI_TABLA) {
+            std::cout << "Fib(" << choice << ") = " << fibonacciTabla(choice) << std::endl;
+            continue;
+        }
+        EnteroGrande f = memo.consulta(choice);
+        if (f.cifras() <= 100)
+            std::cout << "Fib(" << choice << ") = " << f << std::endl;
+        else
+            std::cout << "Fib(" << choice << ") has " << f.cifras() << " digits: " << f.aCadena().substr(0, 20)
+                      << "..." << std::endl;
     }
 
     std::cout << "Quitting...\n";
@@ -26,3 +53,36 @@ int fibonacci(int n) {
         return n;
     return fibonacci(n - 1) + fibonacci(n - 2);
 }
+
+// Compara la versión recursiva con el doblado y mide `F(n)` para `n` grandes.
+void benchmark() {
+    typedef std::chrono::steady_clock reloj;
+    std::cout << "n\trecursive (ms)\tfast doubling (ms)\ttable (ms)" << std::endl;
+    for (int n = 20; n <= 40; n += 5) {
+        reloj::time_point t0 = reloj::now();
+        volatile int lento = fibonacci(n);
+        reloj::time_point t1 = reloj::now();
+        volatile uint64_t rapido = fibonacci64(n);
+        reloj::time_point t2 = reloj::now();
+        volatile uint64_t tabla = fibonacciTabla(n);
+        reloj::time_point t3 = reloj::now();
+        if (uint64_t(lento) != rapido || rapido != tabla)
+            std::cout << "Mismatch for n = " << n << std::endl;
+        std::cout << n << "\t" << std::chrono::duration<double, std::milli>(t1 - t0).count() << "\t\t"
+                  << std::chrono::duration<double, std::milli>(t2 - t1).count() << "\t\t"
+                  << std::chrono::duration<double, std::milli>(t3 - t2).count() << std::endl;
+    }
+
+    std::cout << std::endl << "n\tdigits\t\ttime (ms)" << std::endl;
+    for (unsigned long n = 1000; n <= 1000000; n *= 10) {
+        reloj::time_point t0 = reloj::now();
+        EnteroGrande f = fibonacciGrande(n);
+        std::cout << n << "\t" << f.cifras() << "\t\t"
+                  << std::chrono::duration<double, std::milli>(reloj::now() - t0).count() << std::endl;
+    }
+
+    // Comprobación: F(n+1) F(n-1) - F(n)^2 = (-1)^n (identidad de Cassini), aquí con n par.
+    EnteroGrande a = fibonacciGrande(99999), b = fibonacciGrande(100000), c = fibonacciGrande(100001);
+    std::cout << std::endl << "Cassini identity for n = 100000: " << (c * a - b * b == EnteroGrande(1) ? "ok" : "FAILED")
+              << std::endl;
+}
@@ -0,0 +1,104 @@
+/*
+ * Números de Fibonacci en `O(log n)` con el método de «doblado» («fast doubling»). De la
+ * forma matricial
+ *      [F(n+1)  F(n)  ]   [1 1]^n
+ *      [F(n)    F(n-1)] = [1 0]
+ * se deduce que
+ *      F(2k)   = F(k) (2 F(k+1) - F(k))
+ *      F(2k+1) = F(k)^2 + F(k+1)^2
+ * así que recorriendo los bits de `n` de mayor a menor pasamos de `(F(k), F(k+1))` a
+ * `(F(2k), F(2k+1))` o a `(F(2k+1), F(2k+2))` con 3 productos por bit. La versión
+ * recursiva de `fibonacci.cpp` hace del orden de `F(n)` llamadas.
+ * Hasta `F(93)` los resultados caben en un `uint64_t`; a partir de ahí usamos los
+ * `EnteroGrande` de `enteroGrande.cpp`, que hay que incluir antes.
+ * `MemoFibonacci` guarda los resultados ya calculados para consultas repetidas y se
+ * puede usar desde varios hilos a la vez. Para compilar hay que pasar `-pthread` a `g++`.
+ */
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+
+#define MAX_FIBONACCI_64 93
+#define MAX_MEMO_FIBONACCI 1024
+
+/*
+ * `F(n)` para `n <= MAX_FIBONACCI_64`. Para `n = 93` el último paso también calcula
+ * `F(94)`, que no cabe y se desborda, pero la aritmética sin signo es módulo `2^64` y
+ * `F(93)` sale exacto.
+ */
+uint64_t fibonacci64(unsigned n) {
+    uint64_t a = 0, b = 1;
+    for (int bit = 31; bit >= 0; bit--) {
+        uint64_t c = a * (2 * b - a), d = a * a + b * b;
+        if ((n >> bit) & 1) {
+            a = d;
+            b = c + d;
+        } else {
+            a = c;
+            b = d;
+        }
+    }
+    return a;
+}
+
+EnteroGrande fibonacciGrande(unsigned long n) {
+    if (n <= MAX_FIBONACCI_64)
+        return EnteroGrande(fibonacci64(n));
+
+    int bit = 63;
+    while (!((n >> bit) & 1))
+        bit--;
+    EnteroGrande a(0), b(1);
+    for (; bit >= 0; bit--) {
+        bool uno = (n >> bit) & 1;
+        // En el último bit solo necesitamos uno de los dos.
+        if (bit == 0)
+            return uno ? a * a + b * b : a * (b + b - a);
+        EnteroGrande c = a * (b + b - a), d = a * a + b * b;
+        if (uno) {
+            a = d;
+            b = c + d;
+        } else {
+            a = c;
+            b = d;
+        }
+    }
+    return a;
+}
+
+/*
+ * Tabla de resultados ya calculados. El cálculo se hace fuera del `mutex`, para que
+ * una consulta lenta no bloquee a las demás; si dos hilos piden a la vez el mismo `n`
+ * lo calculan los dos y se guarda una vez. Con `MAX_MEMO_FIBONACCI` entradas vaciamos
+ * la tabla para no crecer sin límite.
+ */
+class MemoFibonacci {
+  public:
+    EnteroGrande consulta(unsigned long n) {
+        {
+            std::lock_guard<std::mutex> cerrojo(mutex);
+            std::map<unsigned long, EnteroGrande>::const_iterator it = tabla.find(n);
+            if (it != tabla.end()) {
+                aciertos++;
+                return it->second;
+            }
+        }
+        EnteroGrande f = fibonacciGrande(n);
+        std::lock_guard<std::mutex> cerrojo(mutex);
+        if (tabla.size() >= MAX_MEMO_FIBONACCI)
+            tabla.clear();
+        tabla[n] = f;
+        return f;
+    }
+
+    unsigned long numAciertos() {
+        std::lock_guard<std::mutex> cerrojo(mutex);
+        return aciertos;
+    }
+
+  private:
+    std::mutex mutex;
+    std::map<unsigned long, EnteroGrande> tabla;
+    unsigned long aciertos = 0;
+};
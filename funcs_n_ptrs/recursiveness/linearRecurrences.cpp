@@ -0,0 +1,73 @@
+#include <iostream>
+#include <chrono>
+
+#include "potencias.cpp"
+#include "recurrencias.cpp"
+
+// La matriz de Fibonacci al cubo, calculada al compilar: [[F(4), F(3)], [F(3), F(2)]].
+constexpr Matriz<unsigned long long, 2> Q = {{{1, 1}, {1, 0}}};
+static_assert((Q * Q * Q).a[0][0] == 3 && (Q * Q * Q).a[0][1] == 2, "Q^3 != [[3, 2], [2, 1]]");
+
+// `x_n` dando `n` pasos de la recurrencia, para comparar.
+template <typename T, int K>
+T terminoIterativo(const T (&c)[K], const T (&iniciales)[K], unsigned long long n) {
+    T x[K];
+    for (int i = 0; i < K; i++)
+        x[i] = iniciales[i];
+    for (unsigned long long paso = K; paso <= n; paso++) {
+        T nuevo = 0;
+        for (int j = 0; j < K; j++)
+            nuevo += c[j] * x[K - 1 - j];
+        for (int i = 0; i + 1 < K; i++)
+            x[i] = x[i + 1];
+        x[K - 1] = nuevo;
+    }
+    return n < (unsigned long long) K ? iniciales[n] : x[K - 1];
+}
+
+int main() {
+    typedef std::chrono::steady_clock reloj;
+    const uint64_t fibC[2] = {1, 1}, fibIni[2] = {0, 1};
+    std::cout << "Fib(90) = " << terminoRecurrencia(fibC, fibIni, 90) << std::endl;
+
+    // Tribonacci: x_n = x_{n-1} + x_{n-2} + x_{n-3}, con resultados módulo 2^64.
+    const uint64_t tribC[3] = {1, 1, 1}, tribIni[3] = {0, 0, 1};
+    std::cout << std::endl << "Tribonacci modulo 2^64:" << std::endl;
+    std::cout << "n\t\titerative (ms)\tmatrix power (ms)" << std::endl;
+    for (unsigned long long n = 1000000; n <= 1000000000; n *= 10) {
+        reloj::time_point t0 = reloj::now();
+        uint64_t lento = terminoIterativo(tribC, tribIni, n);
+        reloj::time_point t1 = reloj::now();
+        uint64_t rapido = terminoRecurrencia(tribC, tribIni, n);
+        reloj::time_point t2 = reloj::now();
+        std::cout << n << "\t" << std::chrono::duration<double, std::milli>(t1 - t0).count() << "\t\t"
+                  << std::chrono::duration<double, std::milli>(t2 - t1).count() << (lento != rapido ? "\tMISMATCH" : "")
+                  << std::endl;
+    }
+
+    const uint64_t modulo = 1000000007;
+    std::cout << std::endl << "Fib(10^18) mod " << modulo << " = "
+              << terminoRecurrenciaModular(fibC, fibIni, 1000000000000000000ULL, modulo) << std::endl;
+    std::cout << "Tribonacci(10^18) mod " << modulo << " = "
+              << terminoRecurrenciaModular(tribC, tribIni, 1000000000000000000ULL, modulo) << std::endl;
+
+    // Con un módulo de 64 bits los productos ya no se pueden acumular sin reducir.
+    const uint64_t primoGrande = 18446744073709551557ULL;
+    uint64_t f0 = 0, f1 = 1;
+    for (int i = 0; i < 1000000; i++) {
+        uint64_t f2 = ((uint128) f0 + f1) % primoGrande;
+        f0 = f1;
+        f1 = f2;
+    }
+    uint64_t fibGrande = terminoRecurrenciaModular(fibC, fibIni, 1000000, primoGrande);
+    std::cout << "Fib(10^6) mod 2^64 - 59 = " << fibGrande << (fibGrande != f0 ? "\tMISMATCH" : "") << std::endl;
+
+    // Cadena de Markov con 3 estados: la distribución tras muchos pasos es la estacionaria.
+    Matriz<double, 3> p = {{{0.9, 0.1, 0.0}, {0.2, 0.7, 0.1}, {0.1, 0.3, 0.6}}};
+    Matriz<double, 3> pn = potencia(p, 1000000000ULL, Matriz<double, 3>::identidad());
+    std::cout << std::endl << "Markov chain, row of P^(10^9):";
+    for (int j = 0; j < 3; j++)
+        std::cout << " " << pn.a[0][j];
+    std::cout << std::endl;
+    return 0;
+}
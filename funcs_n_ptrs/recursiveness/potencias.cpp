@@ -0,0 +1,85 @@
+/*
+ * Potencias por «exponenciación binaria» («square and multiply»). Si escribimos el
+ * exponente en binario, `x^13 = x^8 * x^4 * x^1`, y las potencias `x, x^2, x^4, x^8...`
+ * salen elevando al cuadrado la anterior: basta con `O(log n)` productos en vez de los
+ * `n` de `powRecursive()`, y sin recursión.
+ * `potencia()` es una plantilla: sirve para cualquier tipo con `*`, como `double`, los
+ * `EnteroGrande` de `enteroGrande.cpp`, matrices (pasando la identidad como `uno`) o los
+ * `EnteroModular` de abajo, con los que las potencias se hacen módulo `m`.
+ * Para exponentes reales usamos `x^y = exp(y log(x))`, que solo tiene sentido para
+ * `x > 0`: una base negativa elevada a un exponente no entero no es un número real.
+ * Con `double` cada cuadrado duplica el error relativo que ya llevaba la base, así que
+ * `potencia()` solo es precisa para exponentes pequeños (ver `potenciaReal()`).
+ * Más información -> https://en.wikipedia.org/wiki/Exponentiation_by_squaring
+ */
+
+#include <cmath>
+#include <cstdint>
+
+// Con `|n| <= 64` la exponenciación binaria de un `double` se equivoca como mucho en unos 32 ulp.
+#define MAX_EXP_CUADRADOS 64
+
+// `unsigned __int128` es una extensión de GCC: `__extension__` evita el aviso de `-Wpedantic`.
+__extension__ typedef unsigned __int128 uint128;
+
+template <typename T>
+T potencia(T base, unsigned long long n, T uno = T(1)) {
+    T resultado = uno;
+    while (n) {
+        if (n & 1)
+            resultado = resultado * base;
+        n >>= 1;
+        if (n)
+            base = base * base;
+    }
+    return resultado;
+}
+
+// Exponente entero con signo: `x^-n = 1 / x^n`.
+double potenciaEntera(double base, long long n) {
+    // `-n` no cabe si `n` es el mínimo `long long`, así que negamos ya como entero sin signo.
+    unsigned long long absoluto = n < 0 ? 0ULL - (unsigned long long) n : n;
+    double r = potencia(base, absoluto);
+    return n < 0 ? 1 / r : r;
+}
+
+/*
+ * Cualquier exponente real:
+ *  - Entero y pequeño (`|n| <= MAX_EXP_CUADRADOS`): exponenciación binaria. Es exacta
+ *    si todos los productos intermedios lo son (e.g. `2^n` o `10^n` con `n <= 22`) y,
+ *    si no, el error de cada producto se duplica en los cuadrados siguientes: en total
+ *    hasta unos `n / 2` ulp.
+ *  - Entero y mayor: ese error ya sería de `n eps`, así que usamos `std::pow()`, que
+ *    se equivoca en menos de 1 ulp.
+ *  - No entero: `exp(y log(x))`, cuyo error relativo crece con `|y log(x)|`.
+ */
+double potenciaReal(double base, double exponente) {
+    if (exponente == std::trunc(exponente)) {
+        if (std::fabs(exponente) <= MAX_EXP_CUADRADOS)
+            return potenciaEntera(base, (long long) exponente);
+        return std::pow(base, exponente);
+    }
+    if (base > 0)
+        return std::exp(exponente * std::log(base));
+    if (base == 0)
+        return exponente > 0 ? 0 : HUGE_VAL;
+    return NAN;
+}
+
+/*
+ * Enteros módulo `m` (con `m < 2^64`). El producto de dos restos no cabe en 64 bits,
+ * así que lo hacemos con 128.
+ */
+struct EnteroModular {
+    uint64_t v, m;
+    EnteroModular(uint64_t valor, uint64_t modulo) : v(valor % modulo), m(modulo) {}
+};
+
+inline EnteroModular operator*(EnteroModular a, EnteroModular b) {
+    return EnteroModular((uint128) a.v * b.v % a.m, a.m);
+}
+
+// `base^n mod m`.
+uint64_t potenciaModular(uint64_t base, unsigned long long n, uint64_t modulo) {
+    return potencia(EnteroModular(base, modulo), n, EnteroModular(1, modulo)).v;
+}
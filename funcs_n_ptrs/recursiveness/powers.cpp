@@ -1,30 +1,139 @@
 #include <iostream>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
 #include <string>
 
+#include "enteroGrande.cpp"
+#include "potencias.cpp"
+#include "tablas.cpp"
+
+// Por encima de este exponente la recursión de `powRecursive()` puede agotar la pila.
+#define MAX_EXP_RECURSIVO 10000
+
 double powRecursive(double, double);
+uint64_t leeNatural(const char*);
+void benchmark();
 
 int main(int argc, char** argv) {
     double base, exponent;
 
-    if (argc != 3) {
-        std::cout << "usage: " << argv[0] << " base exponent\n";
+    if (argc == 2 && std::string(argv[1]) == "--benchmark") {
+        benchmark();
+        return 0;
+    }
+
+    if (argc != 3 && argc != 4) {
+        std::cout << "usage: " << argv[0] << " base exponent [modulus]\n";
+        std::cout << "       " << argv[0] << " --benchmark\n";
         return -1;
     }
 
+    if (argc == 4) {
+        try {
+            uint64_t b = leeNatural(argv[1]), e = leeNatural(argv[2]), m = leeNatural(argv[3]);
+            if (m == 0) {
+                std::cout << "the modulus MUST be positive\n";
+                return -1;
+            }
+            std::cout << b << " ^ " << e << " mod " << m << " = " << potenciaModular(b, e, m) << std::endl;
+        } catch (std::exception const& ex) {
+            std::cout << "error parsing the input arguments: " << ex.what() << '\n';
+            return -1;
+        }
+        return 0;
+    }
+
     try {
         base = std::stod(argv[1], NULL);
         exponent = std::stod(argv[2], NULL);
-    } catch (std::invalid_argument const& ex) {
+    } catch (std::exception const& ex) {
         std::cout << "error parsing the input arguments: " << ex.what() << '\n';
         return -1;
     }
 
-    std::cout << base << " ^ " << exponent << " = " << powRecursive(base, exponent) << std::endl;
+    std::cout << base << " ^ " << exponent << " = " << potenciaReal(base, exponent);
+    // `powRecursive()` solo termina con exponentes enteros no negativos.
+    if (exponent >= 0 && exponent <= MAX_EXP_RECURSIVO && exponent == std::trunc(exponent))
+        std::cout << " == " << powRecursive(base, exponent);
+    std::cout << std::endl;
+
+    // Con base y exponente enteros damos también el resultado exacto, o avisamos si no cabe en 64 bits.
+    if (base >= 2 && base < 1e19 && base == std::trunc(base) && exponent >= 0 && exponent == std::trunc(exponent)) {
+        try {
+            if (exponent > 64)
+                throw std::overflow_error("the power does not fit in 64 bits");
+            uint64_t exacto = potenciaExacta(base, exponent);
+            std::cout << "exact: " << exacto << std::endl;
+        } catch (std::exception const& ex) {
+            std::cout << "exact: " << ex.what() << std::endl;
+        }
+    }
     return 0;
 }
 
+/*
+ * `std::stoull()` acepta un signo `-` y devuelve el número negado módulo 2^64 (`-2` sería
+ * 18446744073709551614), así que lo rechazamos antes.
+ */
+uint64_t leeNatural(const char* s) {
+    std::string texto(s);
+    size_t primero = texto.find_first_not_of(" \t\n\v\f\r");
+    if (primero != std::string::npos && texto[primero] == '-')
+        throw std::invalid_argument("negative numbers are not allowed");
+    return std::stoull(texto, NULL);
+}
+
 double powRecursive(double base, double exp) {
     if (!exp)
         return 1;
     return base * powRecursive(base, exp - 1);
 }
+
+// Tiempo por llamada de `powRecursive()`, `potencia()` y `std::pow()` para exponentes cada vez mayores.
+void benchmark() {
+    typedef std::chrono::steady_clock reloj;
+    const double base = 1.000001;
+    std::cout << "exponent\trecursive (ns)\tsquaring (ns)\tstd::pow (ns)" << std::endl;
+    for (long n = 10; n <= MAX_EXP_RECURSIVO; n *= 10) {
+        long repeticiones = 1000000 / n;
+        volatile double x = base, suma = 0;
+        reloj::time_point t0 = reloj::now();
+        for (long r = 0; r < repeticiones; r++)
+            suma = suma + powRecursive(x, n);
+        reloj::time_point t1 = reloj::now();
+        for (long r = 0; r < repeticiones; r++)
+            suma = suma + potencia(double(x), n);
+        reloj::time_point t2 = reloj::now();
+        for (long r = 0; r < repeticiones; r++)
+            suma = suma + std::pow(double(x), double(n));
+        reloj::time_point t3 = reloj::now();
+        std::cout << n << "\t\t" << std::chrono::duration<double, std::nano>(t1 - t0).count() / repeticiones << "\t\t"
+                  << std::chrono::duration<double, std::nano>(t2 - t1).count() / repeticiones << "\t\t"
+                  << std::chrono::duration<double, std::nano>(t3 - t2).count() / repeticiones << std::endl;
+    }
+
+    // Con enteros grandes: multiplicar n veces por 3 frente a elevar al cuadrado.
+    std::cout << std::endl << "3^n\tdigits\t\tone by one (ms)\tsquaring (ms)" << std::endl;
+    for (unsigned long n = 1000; n <= 1000000; n *= 10) {
+        reloj::time_point t0 = reloj::now();
+        EnteroGrande lento(1);
+        if (n <= 100000)
+            for (unsigned long k = 0; k < n; k++)
+                multiplicaPequeno(lento, 3);
+        reloj::time_point t1 = reloj::now();
+        EnteroGrande rapido = potencia(EnteroGrande(3), n);
+        reloj::time_point t2 = reloj::now();
+        std::cout << n << "\t" << rapido.cifras() << "\t\t";
+        if (n <= 100000)
+            std::cout << std::chrono::duration<double, std::milli>(t1 - t0).count() << (lento != rapido ? " MISMATCH" : "");
+        else
+            std::cout << "-";
+        std::cout << "\t\t" << std::chrono::duration<double, std::milli>(t2 - t1).count() << std::endl;
+    }
+
+    // Pequeño teorema de Fermat: a^(p-1) = 1 mod p para p primo.
+    const uint64_t primo = 18446744073709551557ULL;
+    std::cout << std::endl << "2^(p-1) mod p with p = " << primo << ": " << potenciaModular(2, primo - 1, primo)
+              << std::endl;
+}
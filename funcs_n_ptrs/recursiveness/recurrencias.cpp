@@ -0,0 +1,128 @@
+/*
+ * Recurrencias lineales con potencias de matrices. Una recurrencia de orden `K`,
+ *      x_n = c_0 x_{n-1} + c_1 x_{n-2} + ... + c_{K-1} x_{n-K}
+ * pasa del estado `(x_{n-1}, ..., x_{n-K})` al `(x_n, ..., x_{n-K+1})` multiplicando por
+ * la matriz «compañera», que tiene los coeficientes en la primera fila y unos debajo de
+ * la diagonal. Fibonacci es el caso `K = 2`, `c = {1, 1}`. Así `x_n` sale de
+ * `M^(n-K+1)`, que con `potencia()` de `potencias.cpp` (que hay que incluir antes)
+ * cuesta `O(K^3 log n)` en vez de `O(K n)`. Lo mismo vale para una cadena de Markov:
+ * la distribución tras `n` pasos es la matriz de transición elevada a `n`.
+ * `Matriz<T, N>` es una matriz `N x N` con el tamaño fijado al compilar: vive en la pila,
+ * el compilador desenrolla los bucles del producto y, como las operaciones son
+ * `constexpr` (lo que necesita C++14), puede calcular potencias pequeñas al compilar.
+ * Con `MatrizModular` todas las operaciones se hacen módulo `m > 0`.
+ */
+
+#include <cstdint>
+
+template <typename T, int N>
+struct Matriz {
+    T a[N][N];
+
+    static constexpr Matriz identidad() {
+        Matriz r{};
+        for (int i = 0; i < N; i++)
+            r.a[i][i] = 1;
+        return r;
+    }
+};
+
+template <typename T, int N>
+constexpr Matriz<T, N> operator*(Matriz<T, N> const& x, Matriz<T, N> const& y) {
+    Matriz<T, N> r{};
+#pragma GCC unroll 8
+    for (int i = 0; i < N; i++)
+#pragma GCC unroll 8
+        for (int k = 0; k < N; k++)
+#pragma GCC unroll 8
+            for (int j = 0; j < N; j++)
+                r.a[i][j] += x.a[i][k] * y.a[k][j];
+    return r;
+}
+
+// `y = M x`.
+template <typename T, int N>
+constexpr void aplica(Matriz<T, N> const& m, const T (&x)[N], T (&y)[N]) {
+    for (int i = 0; i < N; i++) {
+        y[i] = 0;
+        for (int j = 0; j < N; j++)
+            y[i] += m.a[i][j] * x[j];
+    }
+}
+
+// Matriz compañera de la recurrencia con coeficientes `c`.
+template <typename T, int K>
+constexpr Matriz<T, K> companera(const T (&c)[K]) {
+    Matriz<T, K> m{};
+    for (int j = 0; j < K; j++)
+        m.a[0][j] = c[j];
+    for (int i = 1; i < K; i++)
+        m.a[i][i - 1] = 1;
+    return m;
+}
+
+/*
+ * `x_n` para la recurrencia con coeficientes `c` y valores iniciales
+ * `iniciales[i] = x_i`, `i < K`. Con enteros sin signo el resultado es módulo `2^64`.
+ */
+template <typename T, int K>
+T terminoRecurrencia(const T (&c)[K], const T (&iniciales)[K], unsigned long long n) {
+    if (n < (unsigned long long) K)
+        return iniciales[n];
+    Matriz<T, K> m = potencia(companera(c), n - K + 1, Matriz<T, K>::identidad());
+    // El estado inicial es `(x_{K-1}, ..., x_0)`: los valores iniciales al revés.
+    T x = 0;
+    for (int j = 0; j < K; j++)
+        x += m.a[0][j] * iniciales[K - 1 - j];
+    return x;
+}
+
+/*
+ * Matriz de enteros módulo `m`. Sumamos los `N` productos de cada elemento en 128 bits
+ * y reducimos una sola vez, lo que con `m < 2^60` no se desborda para `N <= 256`. Con
+ * módulos mayores reducimos cada producto antes de sumarlo, que es más lento.
+ */
+template <int N>
+struct MatrizModular {
+    Matriz<uint64_t, N> x;
+    uint64_t m;
+};
+
+template <int N>
+MatrizModular<N> operator*(MatrizModular<N> const& p, MatrizModular<N> const& q) {
+    MatrizModular<N> r;
+    r.m = p.m;
+#pragma GCC unroll 8
+    for (int i = 0; i < N; i++)
+#pragma GCC unroll 8
+        for (int j = 0; j < N; j++) {
+            uint128 s = 0;
+            if (N <= 256 && p.m < (1ULL << 60)) {
+#pragma GCC unroll 8
+                for (int k = 0; k < N; k++)
+                    s += (uint128) p.x.a[i][k] * q.x.a[k][j];
+            } else {
+                for (int k = 0; k < N; k++)
+                    s += (uint128) p.x.a[i][k] * q.x.a[k][j] % p.m;
+            }
+            r.x.a[i][j] = s % p.m;
+        }
+    return r;
+}
+
+// `x_n mod m` con `m > 0` cualquiera.
+template <int K>
+uint64_t terminoRecurrenciaModular(const uint64_t (&c)[K], const uint64_t (&iniciales)[K], unsigned long long n,
+                                   uint64_t modulo) {
+    if (n < (unsigned long long) K)
+        return iniciales[n] % modulo;
+    MatrizModular<K> base = {companera(c), modulo}, uno = {Matriz<uint64_t, K>::identidad(), modulo};
+    for (int i = 0; i < K; i++)
+        for (int j = 0; j < K; j++)
+            base.x.a[i][j] %= modulo;
+    MatrizModular<K> p = potencia(base, n - K + 1, uno);
+    uint128 x = 0;
+    for (int j = 0; j < K; j++)
+        x += (uint128) p.x.a[0][j] * (iniciales[K - 1 - j] % modulo) % modulo;
+    return x % modulo;
+}
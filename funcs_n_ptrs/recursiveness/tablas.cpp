@@ -0,0 +1,126 @@
+/*
+ * Tablas calculadas al compilar. Los factoriales, números de Fibonacci y potencias que
+ * caben en un `uint64_t` son muy pocos (`20!`, `F(93)`, `10^19`...), así que en vez de
+ * calcularlos en cada llamada los guardamos todos en tablas `constexpr`: el compilador
+ * las rellena con las funciones `constexpr` de abajo y consultarlas es leer un elemento
+ * de un array. Fuera de rango lanzamos `std::out_of_range` en vez de devolver un
+ * resultado desbordado. Los bucles en funciones `constexpr` necesitan C++14.
+ */
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+#define MAX_FACTORIAL_TABLA 20
+#define MAX_FIBONACCI_TABLA 93
+
+template <typename T, int N>
+struct Tabla {
+    T v[N];
+    constexpr T operator[](int i) const { return v[i]; }
+};
+
+constexpr uint64_t factorialConstexpr(unsigned n) {
+    uint64_t f = 1;
+    for (unsigned k = 2; k <= n; k++)
+        f *= k;
+    return f;
+}
+
+/*
+ * Mayor exponente `e` con `base^e` representable en un `uint64_t`. Con `0` y `1` todas
+ * las potencias caben (y el bucle no terminaría o dividiría por 0), así que no tiene
+ * sentido preguntarlo: como en `potenciaConstexpr()`, lanzar es un error de compilación
+ * si se usa al compilar, e.g. en `POTENCIAS<1>`.
+ */
+constexpr unsigned maxExponente(uint64_t base) {
+    if (base < 2)
+        throw std::invalid_argument("every power of 0 and 1 fits in 64 bits");
+    unsigned e = 0;
+    for (uint64_t p = 1; p <= std::numeric_limits<uint64_t>::max() / base; p *= base)
+        e++;
+    return e;
+}
+
+/*
+ * `base^n` exacto. Si no cabe lanza `std::overflow_error`: en una expresión `constexpr`
+ * eso es un error de compilación, así que el desbordamiento no puede pasar desapercibido.
+ */
+constexpr uint64_t potenciaConstexpr(uint64_t base, unsigned n) {
+    uint64_t r = 1;
+    for (unsigned k = 0; k < n; k++) {
+        if (base != 0 && r > std::numeric_limits<uint64_t>::max() / base)
+            throw std::overflow_error("the power does not fit in 64 bits");
+        r *= base;
+    }
+    return r;
+}
+
+constexpr Tabla<uint64_t, MAX_FACTORIAL_TABLA + 1> tablaFactoriales() {
+    Tabla<uint64_t, MAX_FACTORIAL_TABLA + 1> t{};
+    for (int n = 0; n <= MAX_FACTORIAL_TABLA; n++)
+        t.v[n] = factorialConstexpr(n);
+    return t;
+}
+
+// Cada término a partir de los dos anteriores: `O(n)` en total y no `O(n^2)`.
+constexpr Tabla<uint64_t, MAX_FIBONACCI_TABLA + 1> tablaFibonacci() {
+    Tabla<uint64_t, MAX_FIBONACCI_TABLA + 1> t{};
+    t.v[1] = 1;
+    for (int n = 2; n <= MAX_FIBONACCI_TABLA; n++)
+        t.v[n] = t.v[n - 1] + t.v[n - 2];
+    return t;
+}
+
+template <uint64_t B>
+constexpr Tabla<uint64_t, maxExponente(B) + 1> tablaPotencias() {
+    Tabla<uint64_t, maxExponente(B) + 1> t{};
+    t.v[0] = 1;
+    for (unsigned n = 1; n <= maxExponente(B); n++)
+        t.v[n] = t.v[n - 1] * B;
+    return t;
+}
+
+constexpr Tabla<uint64_t, MAX_FACTORIAL_TABLA + 1> FACTORIALES = tablaFactoriales();
+constexpr Tabla<uint64_t, MAX_FIBONACCI_TABLA + 1> FIBONACCI = tablaFibonacci();
+template <uint64_t B>
+constexpr Tabla<uint64_t, maxExponente(B) + 1> POTENCIAS = tablaPotencias<B>();
+
+static_assert(FACTORIALES[MAX_FACTORIAL_TABLA] == 2432902008176640000ULL, "20! mal calculado");
+static_assert(FIBONACCI[MAX_FIBONACCI_TABLA] == 12200160415121876738ULL, "F(93) mal calculado");
+static_assert(maxExponente(10) == 19 && POTENCIAS<10>[19] == 10000000000000000000ULL, "10^19 mal calculado");
+static_assert(potenciaConstexpr(3, 40) == 12157665459056928801ULL, "3^40 mal calculado");
+
+uint64_t factorialTabla(unsigned n) {
+    if (n > MAX_FACTORIAL_TABLA)
+        throw std::out_of_range("n! does not fit in 64 bits for n > 20");
+    return FACTORIALES[n];
+}
+
+uint64_t fibonacciTabla(unsigned n) {
+    if (n > MAX_FIBONACCI_TABLA)
+        throw std::out_of_range("Fib(n) does not fit in 64 bits for n > 93");
+    return FIBONACCI[n];
+}
+
+template <uint64_t B>
+uint64_t potenciaTabla(unsigned n) {
+    if (n > maxExponente(B))
+        throw std::out_of_range("the power does not fit in 64 bits");
+    return POTENCIAS<B>[n];
+}
+
+/*
+ * `base^n` exacto: las bases más habituales salen de las tablas y el resto se calcula
+ * multiplicando. Si no cabe lanza `std::out_of_range` o `std::overflow_error`.
+ */
+uint64_t potenciaExacta(uint64_t base, unsigned n) {
+    switch (base) {
+        case 2:
+            return potenciaTabla<2>(n);
+        case 10:
+            return potenciaTabla<10>(n);
+        default:
+            return potenciaConstexpr(base, n);
+    }
+}